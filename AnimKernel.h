@@ -0,0 +1,87 @@
+/**
+ * @brief Animation kernels specialized on the strip geometry
+ * @file AnimKernel.h
+ * @version 0.1
+ * @date 2026-10-17
+ * @author Nello (nello.chom@protonmail.com)
+ */
+
+#ifndef _ANIM_KERNEL_H_
+#define _ANIM_KERNEL_H_
+
+/*********************************************************************************
+* Includes
+*********************************************************************************/
+#include "config.h"
+
+/*********************************************************************************
+* Types & definitions
+*********************************************************************************/
+/**
+ * Whole frame kernels with the pixel count as template parameter, the loop
+ * bounds are compile time constants so the compiler can unroll or vectorize.
+ */
+template <uint16_t N>
+struct TstAnim_Kernel {
+    static inline void vFill(CRGB* FpLeds, const CRGB& FColor)
+    {
+        for (uint16_t u16Index = 0; u16Index < N; u16Index++)
+        { FpLeds[u16Index] = FColor; }
+    }
+
+    // pixels to send so the wire matches FpNew, trailing equal pixels are skipped
+    static inline uint16_t u16DirtyCount(const CRGB* FpNew, const CRGB* FpWire)
+    {
+        uint16_t u16Count = N;
+        while ((u16Count > 0) && (FpNew[u16Count - 1] == FpWire[u16Count - 1]))
+        { u16Count--; }
+        return u16Count;
+    }
+
+    static inline uint8_t u8IsBlack(const CRGB* FpLeds)
+    {
+        for (uint16_t u16Index = 0; u16Index < N; u16Index++)
+        {
+            if (FpLeds[u16Index].r | FpLeds[u16Index].g | FpLeds[u16Index].b)
+            { return 0; }
+        }
+        return 1;
+    }
+};
+
+/**
+ * Single pixel build: straight line code
+ */
+template <>
+struct TstAnim_Kernel<1> {
+    static inline void vFill(CRGB* FpLeds, const CRGB& FColor)
+    { FpLeds[0] = FColor; }
+
+    static inline uint16_t u16DirtyCount(const CRGB* FpNew, const CRGB* FpWire)
+    { return (FpNew[0] == FpWire[0]) ? 0 : 1; }
+
+    static inline uint8_t u8IsBlack(const CRGB* FpLeds)
+    { return !(FpLeds[0].r | FpLeds[0].g | FpLeds[0].b); }
+};
+
+/**
+ * Device profile: geometry and kernels of one build
+ */
+template <uint16_t N, uint8_t MODE>
+struct TstAnim_Profile {
+    static const bool bStrip = (MODE != DEVICE_SIMPLE);
+    typedef TstAnim_Kernel<N> Kernel;
+};
+
+typedef TstAnim_Profile<NB_PIXELS, DEVICE_MODE> TstAnim_Device;
+
+/*********************************************************************************
+* Functions
+*********************************************************************************/
+static inline void vAnim_Fill(CRGB* FpLeds, const CRGB& FColor)
+{ TstAnim_Device::Kernel::vFill(FpLeds, FColor); }
+
+static inline void vAnim_Clear(CRGB* FpLeds)
+{ TstAnim_Device::Kernel::vFill(FpLeds, CRGB(0, 0, 0)); }
+
+#endif //_ANIM_KERNEL_H_
@@ -12,10 +12,70 @@
 #include <FastLED.h>
 #include "AnimMng.h"
 #include "AnimMngInt.h"
+#include "OutMng.h"
+#include "GestMng.h"
+#include "ImgMng.h"
+#include "ImuMng.h"
+#include "NetMng.h"
+#include "ProfMng.h"
 
 /*********************************************************************************
 * Types & definitions
 *********************************************************************************/
+static_assert(eAnim_NbRun == PROF_NB_TAGS, "one latency stats slot per run mode");
+
+/**
+ * Compile time port of FastLED hsv2rgb_rainbow for full saturation and value,
+ * written as C++11 constexpr (single return) so AVR toolchains accept it.
+ */
+constexpr uint8_t u8Anim_Scale8(uint8_t Fu8Value, uint8_t Fu8Scale)
+{ return (uint8_t)(((uint16_t)Fu8Value * (1 + (uint16_t)Fu8Scale)) >> 8); }
+
+constexpr uint8_t u8Anim_Third(uint8_t Fu8Hue)
+{ return u8Anim_Scale8((uint8_t)((Fu8Hue & 0x1F) << 3), (256 / 3)); }
+
+constexpr uint8_t u8Anim_TwoThirds(uint8_t Fu8Hue)
+{ return u8Anim_Scale8((uint8_t)((Fu8Hue & 0x1F) << 3), ((256 * 2) / 3)); }
+
+constexpr uint8_t u8Anim_RainbowR(uint8_t Fu8Hue)
+{
+    return ((Fu8Hue >> 5) == 0) ? (uint8_t)(255 - u8Anim_Third(Fu8Hue))
+         : ((Fu8Hue >> 5) == 1) ? 171
+         : ((Fu8Hue >> 5) == 2) ? (uint8_t)(171 - u8Anim_TwoThirds(Fu8Hue))
+         : ((Fu8Hue >> 5) == 3) ? 0
+         : ((Fu8Hue >> 5) == 4) ? 0
+         : ((Fu8Hue >> 5) == 5) ? u8Anim_Third(Fu8Hue)
+         : ((Fu8Hue >> 5) == 6) ? (uint8_t)(85 + u8Anim_Third(Fu8Hue))
+         : (uint8_t)(170 + u8Anim_Third(Fu8Hue));
+}
+
+constexpr uint8_t u8Anim_RainbowG(uint8_t Fu8Hue)
+{
+    return ((Fu8Hue >> 5) == 0) ? u8Anim_Third(Fu8Hue)
+         : ((Fu8Hue >> 5) == 1) ? (uint8_t)(85 + u8Anim_Third(Fu8Hue))
+         : ((Fu8Hue >> 5) == 2) ? (uint8_t)(170 + u8Anim_Third(Fu8Hue))
+         : ((Fu8Hue >> 5) == 3) ? (uint8_t)(255 - u8Anim_Third(Fu8Hue))
+         : ((Fu8Hue >> 5) == 4) ? (uint8_t)(171 - u8Anim_TwoThirds(Fu8Hue))
+         : 0;
+}
+
+constexpr uint8_t u8Anim_RainbowB(uint8_t Fu8Hue)
+{
+    return ((Fu8Hue >> 5) <= 2) ? 0
+         : ((Fu8Hue >> 5) == 3) ? u8Anim_Third(Fu8Hue)
+         : ((Fu8Hue >> 5) == 4) ? (uint8_t)(85 + u8Anim_TwoThirds(Fu8Hue))
+         : ((Fu8Hue >> 5) == 5) ? (uint8_t)(255 - u8Anim_Third(Fu8Hue))
+         : ((Fu8Hue >> 5) == 6) ? (uint8_t)(171 - u8Anim_Third(Fu8Hue))
+         : (uint8_t)(85 - u8Anim_Third(Fu8Hue));
+}
+
+#define ANIM_PALETTE_HUE(h)     {u8Anim_RainbowR(h), u8Anim_RainbowG(h), u8Anim_RainbowB(h)}
+
+// settings index one step up or down, wraps around Fu8Count
+static inline uint8_t u8Anim_Wrap(uint8_t Fu8Value, int8_t Fi8Step, uint8_t Fu8Count)
+{
+    return (uint8_t)((Fu8Value + Fu8Count + Fi8Step) % Fu8Count);
+}
 
 /*********************************************************************************
 * Internal functions prototypes
@@ -24,27 +84,80 @@
 /*********************************************************************************
 * Global variables
 *********************************************************************************/
-extern CRGB MainLedStip[];
-static uint32_t u32LastFallingEvent = 0;
 static TeAnim_State eAnim_CurrentState = eAnim_StateRun;
 static TstAnim_Configuration stAnim_MasterConfig;
+static TstAnim_Transition stAnim_Transition = {CRGB::Black, 0};
+static TstAnim_ClickUndo stAnim_ClickUndo;    // setting of the speculative single click
+static TeAnim_Event teAnim_EventQueue[ANIM_EVENT_QUEUE_SIZE];
+static uint8_t u8Anim_EventHead = 0;
+static uint8_t u8Anim_EventTail = 0;
 
-static const uint16_t ctu16BlinkRates[3] = {50, 100, 250};
-static const uint16_t ctu16FadeRates[3] = {32, 16, 8};
-static CRGB ctrgb_Palette[17] = {CRGB::White};
-
-static void (*tpvAnimations[eAnim_NbRun])(CRGB*) = { //animation function pointer array
-    vAnim_RunSolid,
-    vAnim_RunFade,
-    vAnim_RunBlink,
-    vAnim_RunAlternate,
+static const uint16_t ctu16BlinkRates[3] PROGMEM = {50, 100, 250};
+static const uint16_t ctu16FadeTimes[3] PROGMEM = {160, 320, 640};   // ms for a full 0 -> 255 ramp
+static const uint8_t ctu8Anim_Palette[ANIM_COLOR_NB][3] PROGMEM = { // r, g, b
+    {255, 255, 255},
+    ANIM_PALETTE_HUE(0),   ANIM_PALETTE_HUE(16),  ANIM_PALETTE_HUE(32),  ANIM_PALETTE_HUE(48),
+    ANIM_PALETTE_HUE(64),  ANIM_PALETTE_HUE(80),  ANIM_PALETTE_HUE(96),  ANIM_PALETTE_HUE(112),
+    ANIM_PALETTE_HUE(128), ANIM_PALETTE_HUE(144), ANIM_PALETTE_HUE(160), ANIM_PALETTE_HUE(176),
+    ANIM_PALETTE_HUE(192), ANIM_PALETTE_HUE(208), ANIM_PALETTE_HUE(224), ANIM_PALETTE_HUE(240)
+};
 #if (DEVICE_MODE != DEVICE_SIMPLE)
-    vAnim_RunGradient,
-    vAnim_RunBicolor,
-    vAnim_RunEdge
+static CHSV thsvAnim_Palette[ANIM_COLOR_NB];  // palette through rgb2hsv_approximate, gradient input
+static TstAnim_GradientCache stAnim_Gradient = {0xFF, 0xFF, eAnim_BlankNone, {}};
+#endif
+
+static const TstAnim_Renderer ctstAnim_RunModes[eAnim_NbRun] = { // indexed by TeAnim_RunMode
+    {vAnim_RunSolid, eAnim_RateRefresh},
+    {vAnim_RunFade, eAnim_RateRefresh},
+    {vAnim_RunBlink, eAnim_RateBlink},
+#if (DEVICE_MODE == DEVICE_SIMPLE)
+    {vAnim_RunAlternate, eAnim_RateBlink},
+#else
+    {vAnim_RunAlternate, eAnim_RateRefresh},
+    {vAnim_RunGradient, eAnim_RateRefresh},
+    {vAnim_RunBicolor, eAnim_RateRefresh},
+    {vAnim_RunEdge, eAnim_RateRefresh},
+#endif
+#if IMG_PLAYBACK
+    {vAnim_RunImage, eAnim_RateColumn},
+#endif
+#if NET_STREAM
+    {vAnim_RunStream, eAnim_RateStream},
+#endif
+};
+
+static const TstAnim_Renderer ctstAnim_ConfigModes[eAnim_NbRun] = { // indexed by TeAnim_RunMode
+    {vAnim_ConfigNone, eAnim_RateMenu},
+    {vAnim_ConfigFade, eAnim_RateRefresh},
+    {vAnim_ConfigBlink, eAnim_RateBlink},
+#if (DEVICE_MODE == DEVICE_SIMPLE)
+    {vAnim_ConfigAlternate, eAnim_RateMenu},
+#else
+    {vAnim_ConfigAlternate, eAnim_RateRefresh},
+    {vAnim_ConfigGradient, eAnim_RateRefresh},
+    {vAnim_ConfigBicolor, eAnim_RateRefresh},
+    {vAnim_ConfigEdge, eAnim_RateRefresh},
+#endif
+#if IMG_PLAYBACK
+    {vAnim_ConfigNone, eAnim_RateMenu},
+#endif
+#if NET_STREAM
+    {vAnim_ConfigNone, eAnim_RateMenu},
 #endif
 };
 
+static const TstAnim_Renderer cstAnim_Select = {vAnim_MenuSelect, TstAnim_Device::bStrip ? eAnim_RateRefresh : eAnim_RateMenu};
+static const TstAnim_Renderer cstAnim_Transition = {vAnim_RunTransition, eAnim_RateRefresh};
+
+static const TstAnim_Renderer* pstAnim_ActiveRenderer = NULL;
+static TstAnim_Frame stAnim_Frame;
+// ANIM_CLOCK() ticks, compared wrap safe
+static uint32_t su32Anim_Deadline = 0;      // next frame due
+static uint32_t su32Anim_LastFrame = 0;     // previous frame slot, ms remainder carried
+static uint32_t su32Anim_ShowAt = 0;        // slot of the frame being rendered
+static uint32_t su32Anim_RestartAt = 0;
+static uint32_t u32Anim_MissedFrames = 0;
+static uint8_t u8Anim_Restart = 0;
 
 /*********************************************************************************
 * External functions
@@ -56,14 +169,19 @@ static void (*tpvAnimations[eAnim_NbRun])(CRGB*) = { //animation function pointe
  ********************************************************************************/
 void vAnim_Init(void)
 {
-    vUtils_SetModeCallback(eUtils_Falling, vAnim_CbClickFall);
-    vUtils_SetModeCallback(eUtils_Rising, vAnim_CbClickRise);
-    vUtils_SetModeCallback(eUtils_Long, vAnim_CbLongClick);
+    vGest_SetCallback(eUtils_Select, eGest_Click, vAnim_CbClick);
+    vGest_SetCallback(eUtils_Select, eGest_DoubleClick, vAnim_CbDoubleClick);
+    vGest_SetCallback(eUtils_Select, eGest_TripleClick, vAnim_CbTripleClick);
+    vGest_SetCallback(eUtils_Select, eGest_Hold, vAnim_CbLongClick);
+    vGest_SetCallback(eUtils_Select, eGest_HoldRepeat, vAnim_CbLongClick);
     vUtils_SetButtonCallback(eUtils_Falling, vAnim_CbClickSubMenu);
-    for (uint8_t u8Index = 0; u8Index < 16; u8Index++)
+    vUtils_SetButtonCallback(eUtils_Rising, vAnim_CbTriggerRise);
+#if (DEVICE_MODE != DEVICE_SIMPLE)
+    for (uint8_t u8Index = 0; u8Index < ANIM_COLOR_NB; u8Index++)
     {
-        ctrgb_Palette[u8Index + 1] = CHSV(u8Index * 16, 255, 255);
+        thsvAnim_Palette[u8Index] = rgb2hsv_approximate(rgbAnim_GetColor(u8Index));
     }
+#endif
     stAnim_MasterConfig.u8MainColorIndex = 1;
     stAnim_MasterConfig.u8SecColorIndex = 4;
     stAnim_MasterConfig.u8BlinkRateIndex = 0;
@@ -71,73 +189,109 @@ void vAnim_Init(void)
     stAnim_MasterConfig.u8EdegeSize = 1;
     stAnim_MasterConfig.eMode = eAnim_RunSolid;
     stAnim_MasterConfig.u8SubMenu = 0;
+#if IMG_PLAYBACK
+    u8Img_Init();
+#endif
 }
 
 /*********************************************************************************
- * @brief Run animation engine
+ * @brief Run animation engine: pick the active renderer and call it when its
+ *        frame is due
+ *
+ * Slots are ANIM_CLOCK() ticks. With PRECISE_TIMING a frame is rendered from
+ * ANIM_EARLY_TICKS before its slot and u8Anim_Show holds the output until the
+ * slot, so the strip latches on a micros() grid whatever the render cost and
+ * the loop jitter (as long as a loop pass is shorter than TIME_FRAME_SPIN_US).
  * 
  * @param Fptr 
  ********************************************************************************/
 void vAnim_CoreMng(CRGB* Fptr)
 {
-    switch(eAnim_CurrentState)
-    {
-        case eAnim_StateRun:
-        tpvAnimations[stAnim_MasterConfig.eMode](Fptr);
-        break;
+    const TstAnim_Renderer* pstRenderer = pstAnim_GetRenderer();
+    uint32_t u32Now = ANIM_CLOCK();
 
-        case eAnim_StateSelect:
-#if (DEVICE_MODE == DEVICE_SIMPLE)
-        vAnim_MenuBlink(Fptr, CRGB::Blue, stAnim_MasterConfig.eMode + 1);
-#else
-        vAnim_MenuStripDisplay(Fptr, CRGB::Red, stAnim_MasterConfig.eMode + 1);
-#endif
-        break;
+    if ((pstRenderer != pstAnim_ActiveRenderer) || u8Anim_Restart)
+    {   // new renderer, first frame is due now (or at the restart time)
+        uint32_t u32Start = u8Anim_Restart ? su32Anim_RestartAt : u32Now;
+        pstAnim_ActiveRenderer = pstRenderer;
+        u8Anim_Restart = 0;
+        stAnim_Frame.u32Index = 0;
+        stAnim_Frame.u32Elapsed = 0;
+        su32Anim_LastFrame = u32Start;
+        su32Anim_Deadline = u32Start;
+    }
 
-        case eAnim_eStateSubParam:
-        switch(stAnim_MasterConfig.eMode)
-        {
-            case eAnim_RunBlink:
-            vAnim_ConfigBlink(Fptr);
-            break;
+    int32_t i32Late = (int32_t)(u32Now - su32Anim_Deadline);
+    if (i32Late < -(int32_t)ANIM_EARLY_TICKS)
+    { return; }
 
-            case eAnim_RunFade:
-            vAnim_ConfigFade(Fptr);
-            break;
+    uint32_t u32Period = u16Anim_GetPeriod(pstRenderer->eRate) * ANIM_TICKS_PER_MS;
+    if (i32Late < 0)
+    {   // early: output waits for the slot
+        su32Anim_ShowAt = su32Anim_Deadline;
+        su32Anim_Deadline += u32Period;
+    }
+    else if ((uint32_t)i32Late >= u32Period)
+    {   // at least one frame slot went by, drop them and restart the cadence
+        if (pstRenderer->eRate != eAnim_RateStream)
+        { u32Anim_MissedFrames += (uint32_t)i32Late / u32Period; }     // socket polls are not frames
+        su32Anim_ShowAt = u32Now;
+        su32Anim_Deadline = u32Now + u32Period;
+    }
+    else
+    {
+        su32Anim_ShowAt = u32Now;
+        su32Anim_Deadline += u32Period;
+    }
 
-            case eAnim_RunAlter:
-#if (DEVICE_MODE == DEVICE_SIMPLE)
-            if(stAnim_MasterConfig.u8SubMenu == 0)
-            { vAnim_MenuBlink(Fptr, ctrgb_Palette[stAnim_MasterConfig.u8MainColorIndex], 1); }
-            else
-            {  vAnim_MenuBlink(Fptr, ctrgb_Palette[stAnim_MasterConfig.u8SecColorIndex], 2); }
-#else
-            vAnim_ConfigAlternate(Fptr);
-#endif
-            break;
-#if (DEVICE_MODE != DEVICE_SIMPLE)
-            case eAnim_RunGradient:
-            vAnim_ConfigGradient(Fptr);
-            break;
+    uint32_t u32DeltaMs = (su32Anim_ShowAt - su32Anim_LastFrame) / ANIM_TICKS_PER_MS;
+    su32Anim_LastFrame += u32DeltaMs * ANIM_TICKS_PER_MS;   // sub ms remainder goes to the next delta
+    stAnim_Frame.u32Elapsed += u32DeltaMs;
+    stAnim_Frame.u16DeltaMs = (uint16_t)u32DeltaMs;
 
-            case eAnim_RunBicolor:
-            vAnim_ConfigBicolor(Fptr);
-            break;
+    PROF_START(u32ProfRender);
+    pstRenderer->pvRender(Fptr, &stAnim_Frame);
+    PROF_STOP(eProf_Render, u32ProfRender);
+    stAnim_Frame.u32Index++;
+}
 
-            case eAnim_RunEdge:
-            vAnim_ConfigEdge(Fptr);
-            break;
+/*********************************************************************************
+ * @brief Number of frame slots skipped because a frame came too late
+ * 
+ * @return uint32_t 
+ ********************************************************************************/
+uint32_t u32Anim_GetMissedFrames(void)
+{
+    return u32Anim_MissedFrames;
+}
+
+/*********************************************************************************
+ * @brief Nothing to animate: run state, trigger released, no transition or
+ *        pending event, and the strip latched black (never in Stream mode,
+ *        packets keep coming)
+ * 
+ * @return uint8_t 1 when the MCU may sleep until the next button edge
+ ********************************************************************************/
+uint8_t u8Anim_IsIdle(void)
+{
+#if NET_STREAM
+    if (stAnim_MasterConfig.eMode == eAnim_RunStream)
+    { return 0; }
 #endif
-            default:
-            vAnim_MenuBlink(Fptr, CRGB::Red, 1);
-            delay(1000);
-            break;
-        }
-        break;
+    return (eAnim_CurrentState == eAnim_StateRun) && !stAnim_Transition.u8Active
+        && (u8Anim_EventHead == u8Anim_EventTail)
+        && (eUtils_GetButtonState(eUtils_Button) == eUtils_Idle)
+        && !u8Out_IsBusy() && TstAnim_Device::Kernel::u8IsBlack(prgbOut_GetFront());
+}
 
-        default:
-        break;
-    }
+/*********************************************************************************
+ * @brief Back from sleep: restart the active renderer from frame 0 instead
+ *        of counting the sleep as missed frames
+ * 
+ ********************************************************************************/
+void vAnim_OnWake(void)
+{
+    vAnim_RestartFrames();
 }
 
 /*********************************************************************************
@@ -145,549 +299,987 @@ void vAnim_CoreMng(CRGB* Fptr)
 *********************************************************************************/
 
 /*********************************************************************************
- * @brief single color fill
+ * @brief Active renderer for the current state
  * 
- * @param FpLeds 
+ * @return const TstAnim_Renderer* 
  ********************************************************************************/
-void vAnim_RunSolid(CRGB* FpLeds)
+const TstAnim_Renderer* pstAnim_GetRenderer(void)
 {
-    static uint32_t u32timeout = 0;
-    if (millis() > u32timeout)
+    if (stAnim_Transition.u8Active)
+    { return &cstAnim_Transition; }
+
+    switch(eAnim_CurrentState)
     {
-        u32timeout = millis() + REFRESH_TIMEOUT;
-        FastLED.clear();
-        if (eUtils_GetButtonState(eUtils_Button) == eUtils_Active)
-        { fill_solid(FpLeds, NB_PIXELS, ctrgb_Palette[stAnim_MasterConfig.u8MainColorIndex]); }
-        FastLED.show();
+        case eAnim_StateSelect:
+        return &cstAnim_Select;
+
+        case eAnim_eStateSubParam:
+        return &ctstAnim_ConfigModes[stAnim_MasterConfig.eMode];
+
+        case eAnim_StateRun:
+        default:
+        return &ctstAnim_RunModes[stAnim_MasterConfig.eMode];
     }
 }
 
 /*********************************************************************************
- * @brief Single color blink
+ * @brief Frame period of a rate class
  * 
- * @param FpLeds 
+ * @param FeRate 
+ * @return uint16_t ms
  ********************************************************************************/
-void vAnim_RunBlink(CRGB* FpLeds)
+uint16_t u16Anim_GetPeriod(TeAnim_Rate FeRate)
 {
-    static uint8_t su8FlipFlop = 0;
-    static uint32_t su32RefreshTimeOut = 0;
-    if (millis() > su32RefreshTimeOut)
+    switch(FeRate)
     {
-        su32RefreshTimeOut = millis() + ctu16BlinkRates[stAnim_MasterConfig.u8BlinkRateIndex];
-        su8FlipFlop ^= 1;
-        FastLED.clear();
-        if (su8FlipFlop && (eUtils_GetButtonState(eUtils_Button) == eUtils_Active)) 
-        { fill_solid(FpLeds, NB_PIXELS, ctrgb_Palette[stAnim_MasterConfig.u8MainColorIndex]); }
-        FastLED.show();
+        case eAnim_RateBlink:
+        return pgm_read_word(&ctu16BlinkRates[stAnim_MasterConfig.u8BlinkRateIndex]);
+
+        case eAnim_RateMenu:
+        return TIME_MENU_BLINK_ON;
+
+        case eAnim_RateColumn:
+        return (1000 / IMG_COLUMN_RATE_HZ);
+
+        case eAnim_RateStream:
+        return NET_POLL_MS;
+
+        case eAnim_RateRefresh:
+        default:
+        return REFRESH_TIMEOUT;
     }
 }
 
 /*********************************************************************************
- * @brief Single color fade in/out
+ * @brief Palette color from flash
  * 
- * @param FpLeds 
+ * @param Fu8Index < ANIM_COLOR_NB
+ * @return CRGB 
+ ********************************************************************************/
+CRGB rgbAnim_GetColor(uint8_t Fu8Index)
+{
+    return CRGB(pgm_read_byte(&ctu8Anim_Palette[Fu8Index][0]),
+                pgm_read_byte(&ctu8Anim_Palette[Fu8Index][1]),
+                pgm_read_byte(&ctu8Anim_Palette[Fu8Index][2]));
+}
+
+/*********************************************************************************
+ * @brief Move an 8.8 fade level toward full or black by the time elapsed, so
+ *        the fade length does not depend on the frame rate or dropped frames
+ * 
+ * @param Fpu16Level 8.8 level, 0 .. ANIM_FADE_FULL
+ * @param Fu8Up 1: fade in, 0: fade out
+ * @param Fu16DeltaMs time since previous step
+ * @return uint8_t 1 when the level sits on its bound
  ********************************************************************************/
-void vAnim_RunFade(CRGB* FpLeds)
+uint8_t u8Anim_FadeStep(uint16_t* Fpu16Level, uint8_t Fu8Up, uint16_t Fu16DeltaMs)
 {
-    static uint32_t su32Timeout = 0;
-    static uint8_t su8FadeIndex = 0;
-    if (millis() > su32Timeout)
+    uint16_t u16Duration = pgm_read_word(&ctu16FadeTimes[stAnim_MasterConfig.u8FadeRateIndex]);
+    uint32_t u32Step = ((uint32_t)Fu16DeltaMs * ANIM_FADE_FULL) / u16Duration;
+
+    if (Fu8Up)
     {
-        su32Timeout = millis() + REFRESH_TIMEOUT;
-        fill_solid(FpLeds, NB_PIXELS, ctrgb_Palette[stAnim_MasterConfig.u8MainColorIndex]);
-        if (eUtils_GetButtonState(eUtils_Button) == eUtils_Active)
+        if (((uint32_t)*Fpu16Level + u32Step) >= ANIM_FADE_FULL)
         {
-            if ((int)(su8FadeIndex + ctu16FadeRates[stAnim_MasterConfig.u8FadeRateIndex]) > 255)
-            { su8FadeIndex = 255; }
-            else
-            { su8FadeIndex += ctu16FadeRates[stAnim_MasterConfig.u8FadeRateIndex]; }
+            *Fpu16Level = ANIM_FADE_FULL;
+            return 1;
         }
-        else
+        *Fpu16Level += (uint16_t)u32Step;
+    }
+    else
+    {
+        if (u32Step >= *Fpu16Level)
         {
-            if ((int)(su8FadeIndex - ctu16FadeRates[stAnim_MasterConfig.u8FadeRateIndex]) < 0)
-            { su8FadeIndex = 0; }
-            else
-            { su8FadeIndex -= ctu16FadeRates[stAnim_MasterConfig.u8FadeRateIndex]; }
+            *Fpu16Level = 0;
+            return 1;
         }
-        nscale8(FpLeds, NB_PIXELS, su8FadeIndex);
-        FastLED.show();
+        *Fpu16Level -= (uint16_t)u32Step;
     }
+    return 0;
 }
 
-#if (DEVICE_MODE == DEVICE_SIMPLE)
 /*********************************************************************************
- * @brief Alternating colors
+ * @brief Restart the active renderer from frame 0 on next call
+ * 
+ ********************************************************************************/
+void vAnim_RestartFrames(void)
+{
+    u8Anim_Restart = 1;
+    su32Anim_RestartAt = ANIM_CLOCK();
+}
+
+/*********************************************************************************
+ * @brief Restart the active renderer with frame 0 slot at a past micros()
+ *        time, e.g. the sample that committed a trigger edge: the slots stay
+ *        on the edge grid whatever the loop did since (millis() timing
+ *        restarts now)
+ * 
+ * @param Fu32Us micros() timestamp, less than a frame period ago
+ ********************************************************************************/
+void vAnim_RestartFramesAt(uint32_t Fu32Us)
+{
+    u8Anim_Restart = 1;
+#if PRECISE_TIMING
+    su32Anim_RestartAt = Fu32Us;
+#else
+    su32Anim_RestartAt = millis();
+#endif
+}
+
+/*********************************************************************************
+ * @brief Push frame only up to the last pixel that differs from the wire,
+ *        pixels after it keep their latched value
  * 
  * @param FpLeds 
+ * @return uint8_t 1 when the frame went out, 0 when the wire already holds it
  ********************************************************************************/
-void vAnim_RunAlternate(CRGB* FpLeds)
+uint8_t u8Anim_Show(CRGB* FpLeds)
 {
-    static uint32_t su32Timeout = 0;
-    static uint8_t su8FlipFlop = 0;
-    if (millis() > su32Timeout)
-    {
-        su32Timeout = millis() + ctu16BlinkRates[stAnim_MasterConfig.u8BlinkRateIndex];
-        su8FlipFlop ^= 1;
-        FastLED.clear();
+    uint16_t u16Count = TstAnim_Device::Kernel::u16DirtyCount(FpLeds, prgbOut_GetFront());
 
-        if (eUtils_GetButtonState(eUtils_Button) == eUtils_Active)
-        {
-            if (su8FlipFlop)
-            { fill_solid(FpLeds, NB_PIXELS, ctrgb_Palette[stAnim_MasterConfig.u8MainColorIndex]); }
-            else
-            { fill_solid(FpLeds, NB_PIXELS, ctrgb_Palette[stAnim_MasterConfig.u8SecColorIndex]); }
-        }
-        FastLED.show();
+    if (!u16Count)
+    { return 0; }
+
+#if PRECISE_TIMING
+    int32_t i32Wait = (int32_t)(su32Anim_ShowAt - micros());
+    if ((i32Wait > 0) && (i32Wait <= TIME_FRAME_SPIN_US))
+    {   // frame rendered early, latch it on its slot
+        PROF_START(u32ProfSlot);
+        delayMicroseconds((uint32_t)i32Wait);
+        PROF_STOP(eProf_Slot, u32ProfSlot);
     }
+#endif
+    vOut_Submit(FpLeds, u16Count, FastLED.getBrightness());
+    PROF_TRACE_SHOW(((eAnim_CurrentState == eAnim_StateRun) && !stAnim_Transition.u8Active) ? (uint8_t)stAnim_MasterConfig.eMode : PROF_TAG_NONE,
+        !TstAnim_Device::Kernel::u8IsBlack(FpLeds));
+    return 1;
 }
-#else // led strip
+
+#if (DEVICE_MODE != DEVICE_SIMPLE)
 /*********************************************************************************
- * @brief Alternating colors
+ * @brief Draw a run list, cost scales with the number of lit pixels instead
+ *        of a branch per strip pixel
  * 
  * @param FpLeds 
+ * @param FpstSpans 
+ * @param Fu8Count 
  ********************************************************************************/
-void vAnim_RunAlternate(CRGB* FpLeds)
+void vAnim_FillSpans(CRGB* FpLeds, const TstAnim_Span* FpstSpans, uint8_t Fu8Count)
 {
-    static uint32_t su32Timeout = 0;
-    if (millis() > su32Timeout)
+    for (uint8_t u8Span = 0; u8Span < Fu8Count; u8Span++)
     {
-        su32Timeout = millis() + REFRESH_TIMEOUT;
-        FastLED.clear();
-        if (eUtils_GetButtonState(eUtils_Button) == eUtils_Active)
+        const TstAnim_Span* pstSpan = &FpstSpans[u8Span];
+        CRGB* pLed = &FpLeds[pstSpan->u16Start];
+
+        if (pstSpan->u8Stride <= 1)
+        { fill_solid(pLed, pstSpan->u16Length, pstSpan->rgbColor); }
+        else
         {
-            for (uint8_t u8Index = 0; u8Index < NB_PIXELS; u8Index++)
+            for (uint16_t u16Index = 0; u16Index < pstSpan->u16Length; u16Index++)
             {
-                if ((u8Index % 2) == 0)
-                { FpLeds[u8Index] = ctrgb_Palette[stAnim_MasterConfig.u8MainColorIndex]; }
-                else
-                { FpLeds[u8Index] = ctrgb_Palette[stAnim_MasterConfig.u8SecColorIndex]; }
+                *pLed = pstSpan->rgbColor;
+                pLed += pstSpan->u8Stride;
             }
         }
-        FastLED.show();
     }
 }
 
 /*********************************************************************************
- * @brief Gradient with main and secondary color
+ * @brief Edge runs of u8EdegeSize pixels at both ends, the whole strip when
+ *        the edges overlap
  * 
- * @param FpLeds 
+ * @param FpstSpans at least 2 entries
+ * @param FColor 
+ * @return uint8_t number of spans: 2 for separate edges, 1 when they overlap
  ********************************************************************************/
-void vAnim_RunGradient(CRGB* FpLeds)
+uint8_t u8Anim_EdgeSpans(TstAnim_Span* FpstSpans, CRGB FColor)
 {
-    static uint32_t su32Timeout = 0;
-    if (millis() > su32Timeout)
+    uint16_t u16Edge = stAnim_MasterConfig.u8EdegeSize;
+
+    FpstSpans[0].u16Start = 0;
+    FpstSpans[0].u8Stride = 1;
+    FpstSpans[0].rgbColor = FColor;
+    if ((2 * u16Edge) >= NB_PIXELS)
     {
-        su32Timeout = millis() + REFRESH_TIMEOUT;
-        FastLED.clear();
-        if (eUtils_GetButtonState(eUtils_Button) == eUtils_Active)
-        {
-            CHSV Main = rgb2hsv_approximate(ctrgb_Palette[stAnim_MasterConfig.u8MainColorIndex]);
-            CHSV Secondary = rgb2hsv_approximate(ctrgb_Palette[stAnim_MasterConfig.u8SecColorIndex]);
-            fill_gradient(FpLeds, NB_PIXELS, Main, Secondary);
-        }
-        FastLED.show();
+        FpstSpans[0].u16Length = NB_PIXELS;
+        return 1;
     }
+
+    FpstSpans[0].u16Length = u16Edge;
+    FpstSpans[1] = FpstSpans[0];
+    FpstSpans[1].u16Start = NB_PIXELS - u16Edge;
+    return 2;
 }
 
 /*********************************************************************************
- * @brief Edge fill with secondary color
+ * @brief Main to secondary color gradient, rendered once per color pair and
+ *        copied from the cache on following frames
  * 
  * @param FpLeds 
+ * @param Fu8Main palette index
+ * @param Fu8Sec palette index
+ * @param FeBlank side replaced by black
  ********************************************************************************/
-void vAnim_RunEdge(CRGB* FpLeds)
+void vAnim_FillGradient(CRGB* FpLeds, uint8_t Fu8Main, uint8_t Fu8Sec, TeAnim_Blank FeBlank)
 {
-    static uint32_t su32Timeout = 0;
-    if (millis() > su32Timeout)
+    if ((stAnim_Gradient.u8MainColorIndex != Fu8Main) || (stAnim_Gradient.u8SecColorIndex != Fu8Sec)
+        || (stAnim_Gradient.eBlank != FeBlank))
     {
-        su32Timeout = millis() + REFRESH_TIMEOUT;
-        FastLED.clear();
-        if (eUtils_GetButtonState(eUtils_Button) == eUtils_Active)
-        {
-            for (uint8_t u8Index = 0; u8Index < NB_PIXELS; u8Index++)
-            {
-                if (u8Index < stAnim_MasterConfig.u8EdegeSize || u8Index >= (NB_PIXELS - stAnim_MasterConfig.u8EdegeSize))
-                { FpLeds[u8Index] = ctrgb_Palette[stAnim_MasterConfig.u8SecColorIndex]; }
-                else
-                {  FpLeds[u8Index] = ctrgb_Palette[stAnim_MasterConfig.u8MainColorIndex]; }
-            }
-        }
-        FastLED.show();
+        CHSV Main = (FeBlank == eAnim_BlankMain) ? CHSV(0, 0, 0) : thsvAnim_Palette[Fu8Main];
+        CHSV Secondary = (FeBlank == eAnim_BlankSec) ? CHSV(0, 0, 0) : thsvAnim_Palette[Fu8Sec];
+        fill_gradient(stAnim_Gradient.trgbPixels, NB_PIXELS, Main, Secondary);
+        stAnim_Gradient.u8MainColorIndex = Fu8Main;
+        stAnim_Gradient.u8SecColorIndex = Fu8Sec;
+        stAnim_Gradient.eBlank = FeBlank;
     }
+    memcpy(FpLeds, stAnim_Gradient.trgbPixels, sizeof(stAnim_Gradient.trgbPixels));
 }
+#endif
 
 /*********************************************************************************
- * @brief Bicolor fill, split half with main and sec color
+ * @brief single color fill
  * 
  * @param FpLeds 
+ * @param FpstFrame 
  ********************************************************************************/
-void vAnim_RunBicolor(CRGB* FpLeds)
+void vAnim_RunSolid(CRGB* FpLeds, const TstAnim_Frame* FpstFrame)
 {
-    static uint32_t su32Timeout = 0;
-    if (millis() > su32Timeout)
-    {
-        su32Timeout = millis() + REFRESH_TIMEOUT;
-        FastLED.clear();
-        if (eUtils_GetButtonState(eUtils_Button) == eUtils_Active)
-        {
-            for (uint8_t u8Index = 0; u8Index < NB_PIXELS; u8Index++)
-            {
-                if (u8Index < (NB_PIXELS / 2))
-                { FpLeds[u8Index] = ctrgb_Palette[stAnim_MasterConfig.u8MainColorIndex]; }
-                else
-                { FpLeds[u8Index] = ctrgb_Palette[stAnim_MasterConfig.u8SecColorIndex]; }
-            }
-        }
-        FastLED.show();
-    }
+    vAnim_Clear(FpLeds);
+    if (eUtils_GetButtonState(eUtils_Button) == eUtils_Active)
+    { vAnim_Fill(FpLeds, rgbAnim_GetColor(stAnim_MasterConfig.u8MainColorIndex)); }
+    u8Anim_Show(FpLeds);
 }
-#endif
 
 /*********************************************************************************
- * @brief Configuring blink rates
+ * @brief Single color blink, one frame per blink period
  * 
  * @param FpLeds 
+ * @param FpstFrame 
  ********************************************************************************/
-void vAnim_ConfigBlink(CRGB* FpLeds)
+void vAnim_RunBlink(CRGB* FpLeds, const TstAnim_Frame* FpstFrame)
 {
-    static uint32_t su32Timeout = 0;
-    static uint8_t su8FlipFlop = 0;
-    if (millis() > su32Timeout)
-    {
-        su32Timeout = millis() + ctu16BlinkRates[stAnim_MasterConfig.u8BlinkRateIndex];
-        su8FlipFlop ^= 1;
-        FastLED.clear();
-        if(su8FlipFlop)
-        {
-            fill_solid(FpLeds, NB_PIXELS, CRGB::White);
-        }
-        FastLED.show();
-    }
+    vAnim_Clear(FpLeds);
+    if (((FpstFrame->u32Index % 2) == 0) && (eUtils_GetButtonState(eUtils_Button) == eUtils_Active)) 
+    { vAnim_Fill(FpLeds, rgbAnim_GetColor(stAnim_MasterConfig.u8MainColorIndex)); }
+    u8Anim_Show(FpLeds);
 }
 
 /*********************************************************************************
- * @brief Configuring fading rates
+ * @brief Single color fade in/out
  * 
  * @param FpLeds 
+ * @param FpstFrame 
  ********************************************************************************/
-void vAnim_ConfigFade(CRGB* FpLeds)
+void vAnim_RunFade(CRGB* FpLeds, const TstAnim_Frame* FpstFrame)
 {
-    static uint32_t su32Timeout = 0;
-    static uint8_t su8FadeIndex = 0;
-    static uint8_t su8FlipFlop = 0;
+    static uint16_t su16FadeLevel = 0;
+    CRGB rgbColor = rgbAnim_GetColor(stAnim_MasterConfig.u8MainColorIndex);
 
-    if (millis() > su32Timeout)
-    {
-        su32Timeout = millis() + REFRESH_TIMEOUT;
-        fill_solid(FpLeds, NB_PIXELS, CRGB::White);
-        if (su8FlipFlop)
-        {
-            if ((int)(su8FadeIndex + ctu16FadeRates[stAnim_MasterConfig.u8FadeRateIndex]) > 255)
-            {
-                su8FadeIndex = 255;
-                su8FlipFlop ^= 1;
-            }
-            else
-            { su8FadeIndex += ctu16FadeRates[stAnim_MasterConfig.u8FadeRateIndex]; }
-        }
-        else
-        {
-            if ((int)(su8FadeIndex - ctu16FadeRates[stAnim_MasterConfig.u8FadeRateIndex]) < 0)
-            {
-                su8FadeIndex = 0;
-                su8FlipFlop ^= 1;
-            }
-            else
-            { su8FadeIndex -= ctu16FadeRates[stAnim_MasterConfig.u8FadeRateIndex]; }
-        }
-        
-        nscale8(FpLeds, NB_PIXELS, su8FadeIndex);
-        FastLED.show();
-    }
+    u8Anim_FadeStep(&su16FadeLevel, eUtils_GetButtonState(eUtils_Button) == eUtils_Active, FpstFrame->u16DeltaMs);
+
+    // every pixel holds the same color: scale it once, same result as nscale8 on the strip
+    rgbColor.nscale8(su16FadeLevel >> 8);
+    vAnim_Fill(FpLeds, rgbColor);
+    u8Anim_Show(FpLeds);
 }
 
-#if (DEVICE_MODE != DEVICE_SIMPLE)
+#if (DEVICE_MODE == DEVICE_SIMPLE)
 /*********************************************************************************
- * @brief Configure gradient fill
+ * @brief Alternating colors, one frame per blink period
  * 
  * @param FpLeds 
+ * @param FpstFrame 
  ********************************************************************************/
-void vAnim_ConfigGradient(CRGB* FpLeds)
+void vAnim_RunAlternate(CRGB* FpLeds, const TstAnim_Frame* FpstFrame)
 {
-    static uint32_t su32Timeout = 0;
-    static uint32_t su32TimeoutBlink = 0;
-    static uint8_t su8FlipFlop = 0;
-
-    if (millis() > su32TimeoutBlink)
-    {
-        su32TimeoutBlink = millis() + 300;
-        su8FlipFlop ^= 1;
-    }
-    if (millis() > su32Timeout)
+    vAnim_Clear(FpLeds);
+    if (eUtils_GetButtonState(eUtils_Button) == eUtils_Active)
     {
-        su32Timeout = millis() + REFRESH_TIMEOUT;
-        FastLED.clear();
-        CHSV Main = rgb2hsv_approximate(ctrgb_Palette[stAnim_MasterConfig.u8MainColorIndex]);
-        CHSV Secondary = rgb2hsv_approximate(ctrgb_Palette[stAnim_MasterConfig.u8SecColorIndex]);
-        if (su8FlipFlop)
-        {
-            if (!stAnim_MasterConfig.u8SubMenu)
-            { Main = CHSV(0, 0, 0); }
-            else
-            { Secondary = CHSV(0, 0, 0); }
-        }
-        
-        fill_gradient(FpLeds, NB_PIXELS, Main, Secondary);
-        FastLED.show();
+        if ((FpstFrame->u32Index % 2) == 0)
+        { vAnim_Fill(FpLeds, rgbAnim_GetColor(stAnim_MasterConfig.u8MainColorIndex)); }
+        else
+        { vAnim_Fill(FpLeds, rgbAnim_GetColor(stAnim_MasterConfig.u8SecColorIndex)); }
     }
+    u8Anim_Show(FpLeds);
 }
-
+#else // led strip
 /*********************************************************************************
- * @brief Configure dual color
+ * @brief Alternating colors
  * 
  * @param FpLeds 
+ * @param FpstFrame 
  ********************************************************************************/
-void vAnim_ConfigBicolor(CRGB* FpLeds)
+void vAnim_RunAlternate(CRGB* FpLeds, const TstAnim_Frame* FpstFrame)
 {
-    static uint32_t su32Timeout = 0;
-    static uint32_t su32TimeoutBlink = 0;
-    static uint8_t su8FlipFlop = 0;
+    TstAnim_Span tstSpans[2] = {
+        {0, (NB_PIXELS + 1) / 2, 2, rgbAnim_GetColor(stAnim_MasterConfig.u8MainColorIndex)},
+        {1, NB_PIXELS / 2, 2, rgbAnim_GetColor(stAnim_MasterConfig.u8SecColorIndex)}
+    };
 
-    if (millis() > su32TimeoutBlink)
-    {
-        su32TimeoutBlink = millis() + 300;
-        su8FlipFlop ^= 1;
-    }
-    if (millis() > su32Timeout)
-    {
-        su32Timeout = millis() + REFRESH_TIMEOUT;
-        FastLED.clear();
-        
-        for (uint8_t u8Index = 0; u8Index < NB_PIXELS; u8Index++)
-        {
-            if (u8Index < (NB_PIXELS / 2))
-            {
-                if (!stAnim_MasterConfig.u8SubMenu)
-                { FpLeds[u8Index] = (su8FlipFlop) ? ctrgb_Palette[stAnim_MasterConfig.u8MainColorIndex] : CRGB::Black; }
-                else
-                { FpLeds[u8Index] = ctrgb_Palette[stAnim_MasterConfig.u8MainColorIndex]; }
-                
-            }
-            else
-            {
-                if (stAnim_MasterConfig.u8SubMenu)
-                { FpLeds[u8Index] = (su8FlipFlop) ? ctrgb_Palette[stAnim_MasterConfig.u8SecColorIndex] : CRGB::Black; }
-                else
-                { FpLeds[u8Index] = ctrgb_Palette[stAnim_MasterConfig.u8SecColorIndex]; }
-            }
-        }
-    
-        FastLED.show();
-    }
+    vAnim_Clear(FpLeds);
+    if (eUtils_GetButtonState(eUtils_Button) == eUtils_Active)
+    { vAnim_FillSpans(FpLeds, tstSpans, 2); }
+    u8Anim_Show(FpLeds);
 }
 
 /*********************************************************************************
- * @brief Configure color alternate
+ * @brief Gradient with main and secondary color
  * 
  * @param FpLeds 
+ * @param FpstFrame 
  ********************************************************************************/
-void vAnim_ConfigAlternate(CRGB* FpLeds)
+void vAnim_RunGradient(CRGB* FpLeds, const TstAnim_Frame* FpstFrame)
 {
-    static uint32_t su32Timeout = 0;
-    static uint32_t su32TimeoutBlink = 0;
-    static uint8_t su8FlipFlop = 0;
-
-    if (millis() > su32TimeoutBlink)
-    {
-        su32TimeoutBlink = millis() + 300;
-        su8FlipFlop ^= 1;
-    }
-    if (millis() > su32Timeout)
+    vAnim_Clear(FpLeds);
+    if (eUtils_GetButtonState(eUtils_Button) == eUtils_Active)
     {
-        su32Timeout = millis() + REFRESH_TIMEOUT;
-        FastLED.clear();
-        
-        for (uint8_t u8Index = 0; u8Index < 4; u8Index++)
-        {
-            if (u8Index < 2)
-            {
-                if (!stAnim_MasterConfig.u8SubMenu)
-                { FpLeds[u8Index] = (su8FlipFlop) ? ctrgb_Palette[stAnim_MasterConfig.u8MainColorIndex] : CRGB::Black; }
-                else
-                { FpLeds[u8Index] = ctrgb_Palette[stAnim_MasterConfig.u8MainColorIndex]; }
-                
-            }
-            else
-            {
-                if (stAnim_MasterConfig.u8SubMenu)
-                { FpLeds[u8Index] = (su8FlipFlop) ? ctrgb_Palette[stAnim_MasterConfig.u8SecColorIndex] : CRGB::Black; }
-                else
-                { FpLeds[u8Index] = ctrgb_Palette[stAnim_MasterConfig.u8SecColorIndex]; }
-            }
-        }
-        FastLED.show();
+        vAnim_FillGradient(FpLeds, stAnim_MasterConfig.u8MainColorIndex, stAnim_MasterConfig.u8SecColorIndex, eAnim_BlankNone);
     }
+    u8Anim_Show(FpLeds);
 }
 
 /*********************************************************************************
- * @brief Configure color edges
+ * @brief Edge fill with secondary color
  * 
  * @param FpLeds 
+ * @param FpstFrame 
  ********************************************************************************/
-void vAnim_ConfigEdge(CRGB* FpLeds)
+void vAnim_RunEdge(CRGB* FpLeds, const TstAnim_Frame* FpstFrame)
 {
-    static uint32_t su32Timeout = 0;
-    if (millis() > su32Timeout)
+    TstAnim_Span tstSpans[3];
+    uint8_t u8Count = u8Anim_EdgeSpans(tstSpans, rgbAnim_GetColor(stAnim_MasterConfig.u8SecColorIndex));
+
+    vAnim_Clear(FpLeds);
+    if (eUtils_GetButtonState(eUtils_Button) == eUtils_Active)
     {
-        su32Timeout = millis() + REFRESH_TIMEOUT;
-        FastLED.clear();
-        for (uint8_t u8Index = 0; u8Index < NB_PIXELS; u8Index++)
-        {
-            if (u8Index < stAnim_MasterConfig.u8EdegeSize || u8Index >= (NB_PIXELS - stAnim_MasterConfig.u8EdegeSize))
-            {
-                FpLeds[u8Index] = CRGB::White;
-            }
+        if (u8Count == 2)
+        {   // fill between the edges
+            tstSpans[2].u16Start = tstSpans[0].u16Length;
+            tstSpans[2].u16Length = NB_PIXELS - (2 * tstSpans[0].u16Length);
+            tstSpans[2].u8Stride = 1;
+            tstSpans[2].rgbColor = rgbAnim_GetColor(stAnim_MasterConfig.u8MainColorIndex);
+            u8Count++;
         }
-        FastLED.show();
+        vAnim_FillSpans(FpLeds, tstSpans, u8Count);
     }
+    u8Anim_Show(FpLeds);
 }
-#endif ///DEVICE_STRIP
 
 /*********************************************************************************
- * @brief Runtime option click fall
+ * @brief Bicolor fill, split half with main and sec color
  * 
+ * @param FpLeds 
+ * @param FpstFrame 
  ********************************************************************************/
-void vAnim_CbClickFall(void)
+void vAnim_RunBicolor(CRGB* FpLeds, const TstAnim_Frame* FpstFrame)
 {
-    u32LastFallingEvent = millis();
+    TstAnim_Span tstSpans[2] = {
+        {0, NB_PIXELS / 2, 1, rgbAnim_GetColor(stAnim_MasterConfig.u8MainColorIndex)},
+        {NB_PIXELS / 2, NB_PIXELS - (NB_PIXELS / 2), 1, rgbAnim_GetColor(stAnim_MasterConfig.u8SecColorIndex)}
+    };
+
+    vAnim_Clear(FpLeds);
+    if (eUtils_GetButtonState(eUtils_Button) == eUtils_Active)
+    { vAnim_FillSpans(FpLeds, tstSpans, 2); }
+    u8Anim_Show(FpLeds);
 }
+#endif
 
+#if IMG_PLAYBACK
 /*********************************************************************************
- * @brief Long click management
+ * @brief Light painting: one exposure per trigger press, column n on the slot
+ *        n periods after the press (a late frame skips columns rather than
+ *        stretching the image), dark once the image is over, back to the
+ *        first column on release. With IMU_MOTION and a sensor, column n is
+ *        shown once the pen travelled n IMG_COLUMN_PITCH_UM instead
  * 
+ * @param FpLeds 
+ * @param FpstFrame 
  ********************************************************************************/
-void vAnim_CbLongClick(void)
-{   // used to exit menu & submenu
-    switch(eAnim_CurrentState)
-    {
-        case eAnim_StateRun:
-        eAnim_CurrentState = eAnim_StateSelect;
-        vAnim_OnEntrySelect(MainLedStip);
-        break;
-
-        case eAnim_StateSelect:
-        eAnim_CurrentState = eAnim_StateRun;
-        vAnim_OnExitSelect(MainLedStip);
-        break;
-
-        case eAnim_eStateSubParam:
-        eAnim_CurrentState = eAnim_StateSelect;
-        vAnim_OnExitSelect(MainLedStip);
-        break;
+void vAnim_RunImage(CRGB* FpLeds, const TstAnim_Frame* FpstFrame)
+{
+    uint8_t u8Held = (eUtils_GetButtonState(eUtils_Button) == eUtils_Active);
+    uint32_t u32Column = FpstFrame->u32Elapsed / u16Anim_GetPeriod(eAnim_RateColumn);
+#if IMU_MOTION
+    if (!u8Held || (FpstFrame->u32Index == 0))
+    { vImu_ResetStroke(); }     // the stroke starts with the exposure
+    if (u8Imu_IsReady())
+    { u32Column = u32Imu_GetTravelUm() / IMG_COLUMN_PITCH_UM; }
+#endif
+    uint8_t u8Painting = u8Held && (u32Column < u16Img_GetWidth());
 
+    if (u8Painting)
+    {
+        vImg_Seek((uint16_t)u32Column);
+        vImg_GetColumn(FpLeds);
     }
+    else
+    { vAnim_Clear(FpLeds); }
+    u8Anim_Show(FpLeds);
+
+    if (u8Painting)
+    { vImg_Prefetch(); }    // the next column is read while this one is clocked out
+    else if (!u8Held)
+    { vImg_Rewind(); }
 }
+#endif
 
+#if NET_STREAM
 /*********************************************************************************
- * @brief On release click button
+ * @brief Network frames, latched as soon as they are complete instead of on
+ *        the frame grid, while the trigger is held. Packets are decoded even
+ *        when released so the sequence and the counters stay current
  * 
+ * @param FpLeds 
+ * @param FpstFrame 
  ********************************************************************************/
-void vAnim_CbClickRise(void) 
+void vAnim_RunStream(CRGB* FpLeds, const TstAnim_Frame* FpstFrame)
 {
-    uint32_t u32Now = millis();
-    if (((u32Now - u32LastFallingEvent) >= TIME_CLICK_DURATION_MIN) && ((u32Now - u32LastFallingEvent) < TIME_CLICK_DURATION_MAX))
-    {   // short click detected
-        switch(eAnim_CurrentState)
-        {
-            case eAnim_StateRun:
-            switch (stAnim_MasterConfig.eMode)
-            {
-                case eAnim_RunSolid:
-                case eAnim_RunBlink:
-                case eAnim_RunFade:
-                stAnim_MasterConfig.u8MainColorIndex++;
-                stAnim_MasterConfig.u8MainColorIndex %= ANIM_COLOR_NB;
-                break;
+    static uint8_t su8Held = 0;
+    uint8_t u8Held = (eUtils_GetButtonState(eUtils_Button) == eUtils_Active);
+
+    if (u8Held && !su8Held)
+    { vNet_DropFrame(); }   // its first universes were blanked while released
+    su8Held = u8Held;
+
+    uint8_t u8Frame = u8Net_Receive(FpLeds);
+
+    if (!u8Held)
+    {
+        vAnim_Clear(FpLeds);
+        u8Anim_Show(FpLeds);
+    }
+    else if (u8Frame)
+    {
+        su32Anim_ShowAt = ANIM_CLOCK();     // no slot to wait for
+        if (u8Anim_Show(FpLeds))
+        { vNet_OnShown(); }
+    }
+}
+#endif
+
+/*********************************************************************************
+ * @brief Configuring blink rates, one frame per blink period
+ * 
+ * @param FpLeds 
+ * @param FpstFrame 
+ ********************************************************************************/
+void vAnim_ConfigBlink(CRGB* FpLeds, const TstAnim_Frame* FpstFrame)
+{
+    vAnim_Clear(FpLeds);
+    if ((FpstFrame->u32Index % 2) == 0)
+    {
+        vAnim_Fill(FpLeds, CRGB::White);
+    }
+    u8Anim_Show(FpLeds);
+}
+
+/*********************************************************************************
+ * @brief Configuring fading rates
+ * 
+ * @param FpLeds 
+ * @param FpstFrame 
+ ********************************************************************************/
+void vAnim_ConfigFade(CRGB* FpLeds, const TstAnim_Frame* FpstFrame)
+{
+    static uint16_t su16FadeLevel = 0;
+    static uint8_t su8FlipFlop = 0;
+    CRGB rgbColor = CRGB::White;
+
+    if (u8Anim_FadeStep(&su16FadeLevel, su8FlipFlop, FpstFrame->u16DeltaMs))
+    { su8FlipFlop ^= 1; }
+
+    rgbColor.nscale8(su16FadeLevel >> 8);
+    vAnim_Fill(FpLeds, rgbColor);
+    u8Anim_Show(FpLeds);
+}
 
 #if (DEVICE_MODE == DEVICE_SIMPLE)
-                case eAnim_RunAlter:
-                stAnim_MasterConfig.u8BlinkRateIndex++;
-                stAnim_MasterConfig.u8BlinkRateIndex %= 3;
-                break;
+/*********************************************************************************
+ * @brief Configure color alternate, blink the color being edited
+ * 
+ * @param FpLeds 
+ * @param FpstFrame 
+ ********************************************************************************/
+void vAnim_ConfigAlternate(CRGB* FpLeds, const TstAnim_Frame* FpstFrame)
+{
+    if (stAnim_MasterConfig.u8SubMenu == 0)
+    { vAnim_MenuBlink(FpLeds, FpstFrame, rgbAnim_GetColor(stAnim_MasterConfig.u8MainColorIndex), 1); }
+    else
+    { vAnim_MenuBlink(FpLeds, FpstFrame, rgbAnim_GetColor(stAnim_MasterConfig.u8SecColorIndex), 2); }
+}
 #else
-                case eAnim_RunEdge:
-                stAnim_MasterConfig.u8EdegeSize++;
-                stAnim_MasterConfig.u8EdegeSize %= 11;
-                if ((stAnim_MasterConfig.u8EdegeSize > 10) || (!stAnim_MasterConfig.u8EdegeSize))
-                { stAnim_MasterConfig.u8EdegeSize = 1; }
-                break;
+/*********************************************************************************
+ * @brief Configure gradient fill
+ * 
+ * @param FpLeds 
+ * @param FpstFrame 
+ ********************************************************************************/
+void vAnim_ConfigGradient(CRGB* FpLeds, const TstAnim_Frame* FpstFrame)
+{
+    uint8_t u8FlipFlop = ((FpstFrame->u32Elapsed / TIME_CONFIG_BLINK) % 2) == 0;
+
+    TeAnim_Blank eBlank = eAnim_BlankNone;
+
+    if (u8FlipFlop)
+    { eBlank = (!stAnim_MasterConfig.u8SubMenu) ? eAnim_BlankMain : eAnim_BlankSec; }
+
+    vAnim_FillGradient(FpLeds, stAnim_MasterConfig.u8MainColorIndex, stAnim_MasterConfig.u8SecColorIndex, eBlank);
+    u8Anim_Show(FpLeds);
+}
+
+/*********************************************************************************
+ * @brief Configure dual color
+ * 
+ * @param FpLeds 
+ * @param FpstFrame 
+ ********************************************************************************/
+void vAnim_ConfigBicolor(CRGB* FpLeds, const TstAnim_Frame* FpstFrame)
+{
+    uint8_t u8FlipFlop = ((FpstFrame->u32Elapsed / TIME_CONFIG_BLINK) % 2) == 0;
+    TstAnim_Span tstSpans[2] = {
+        {0, NB_PIXELS / 2, 1, rgbAnim_GetColor(stAnim_MasterConfig.u8MainColorIndex)},
+        {NB_PIXELS / 2, NB_PIXELS - (NB_PIXELS / 2), 1, rgbAnim_GetColor(stAnim_MasterConfig.u8SecColorIndex)}
+    };
+
+    if (!u8FlipFlop)
+    {   // blink the half being edited
+        tstSpans[stAnim_MasterConfig.u8SubMenu ? 1 : 0].rgbColor = CRGB::Black;
+    }
+
+    vAnim_Clear(FpLeds);
+    vAnim_FillSpans(FpLeds, tstSpans, 2);
+    u8Anim_Show(FpLeds);
+}
+
+/*********************************************************************************
+ * @brief Configure color alternate
+ * 
+ * @param FpLeds 
+ * @param FpstFrame 
+ ********************************************************************************/
+void vAnim_ConfigAlternate(CRGB* FpLeds, const TstAnim_Frame* FpstFrame)
+{
+    uint8_t u8FlipFlop = ((FpstFrame->u32Elapsed / TIME_CONFIG_BLINK) % 2) == 0;
+    TstAnim_Span tstSpans[2] = {
+        {0, 2, 1, rgbAnim_GetColor(stAnim_MasterConfig.u8MainColorIndex)},
+        {2, 2, 1, rgbAnim_GetColor(stAnim_MasterConfig.u8SecColorIndex)}
+    };
+
+    if (!u8FlipFlop)
+    {   // blink the pair being edited
+        tstSpans[stAnim_MasterConfig.u8SubMenu ? 1 : 0].rgbColor = CRGB::Black;
+    }
+
+    vAnim_Clear(FpLeds);
+    vAnim_FillSpans(FpLeds, tstSpans, 2);
+    u8Anim_Show(FpLeds);
+}
+
+/*********************************************************************************
+ * @brief Configure color edges
+ * 
+ * @param FpLeds 
+ * @param FpstFrame 
+ ********************************************************************************/
+void vAnim_ConfigEdge(CRGB* FpLeds, const TstAnim_Frame* FpstFrame)
+{
+    TstAnim_Span tstSpans[2];
+    uint8_t u8Count = u8Anim_EdgeSpans(tstSpans, CRGB::White);
+
+    vAnim_Clear(FpLeds);
+    vAnim_FillSpans(FpLeds, tstSpans, u8Count);
+    u8Anim_Show(FpLeds);
+}
+#endif ///DEVICE_STRIP
+
+/*********************************************************************************
+ * @brief Sub parameter menu without option, single red blink
+ * 
+ * @param FpLeds 
+ * @param FpstFrame 
+ ********************************************************************************/
+void vAnim_ConfigNone(CRGB* FpLeds, const TstAnim_Frame* FpstFrame)
+{
+    vAnim_MenuBlink(FpLeds, FpstFrame, CRGB::Red, 1);
+}
+
+/*********************************************************************************
+ * @brief Mode button click, applied at once, a double click undoes it
+ * 
+ ********************************************************************************/
+void vAnim_CbClick(void)
+{
+    vAnim_PostEvent(eAnim_EvtShortClick);
+}
+
+/*********************************************************************************
+ * @brief Mode button double click
+ * 
+ ********************************************************************************/
+void vAnim_CbDoubleClick(void)
+{
+    vAnim_PostEvent(eAnim_EvtDoubleClick);
+}
+
+/*********************************************************************************
+ * @brief Mode button triple click
+ * 
+ ********************************************************************************/
+void vAnim_CbTripleClick(void)
+{
+    vAnim_PostEvent(eAnim_EvtTripleClick);
+}
+
+/*********************************************************************************
+ * @brief Long click callback
+ * 
+ ********************************************************************************/
+void vAnim_CbLongClick(void)
+{
+    vAnim_PostEvent(eAnim_EvtLongClick);
+}
+
+/*********************************************************************************
+ * @brief Click tigger button
+ * 
+ ********************************************************************************/
+void vAnim_CbClickSubMenu(void)
+{
+    vAnim_OnTriggerEdge();
+    vAnim_PostEvent(eAnim_EvtSubMenuClick);
+}
+
+/*********************************************************************************
+ * @brief Release tigger button
+ * 
+ ********************************************************************************/
+void vAnim_CbTriggerRise(void)
+{
+    vAnim_OnTriggerEdge();
+}
+
+/*********************************************************************************
+ * @brief Trigger pressed or released while painting: with IMMEDIATE_RESPONSE
+ *        the renderer restarts from frame 0 in this loop, instead of showing
+ *        the edge at its next blink or refresh slot. An image exposure always
+ *        starts on the edge. Frame 0 slot is the debouncer sample that
+ *        committed the edge.
+ * 
+ ********************************************************************************/
+void vAnim_OnTriggerEdge(void)
+{
+    uint8_t u8Restart = IMMEDIATE_RESPONSE;
+
+#if IMG_PLAYBACK
+    u8Restart |= (stAnim_MasterConfig.eMode == eAnim_RunImage);
 #endif
-            }
-            break;
+    if (u8Restart && (eAnim_CurrentState == eAnim_StateRun) && !stAnim_Transition.u8Active)
+    { vAnim_RestartFramesAt(u32Utils_GetSampleTime()); }
+}
 
-            case eAnim_StateSelect:
-            stAnim_MasterConfig.eMode = (TeAnim_RunMode)((stAnim_MasterConfig.eMode + 1) % eAnim_NbRun);
-            break;
+/*********************************************************************************
+ * @brief Run or queue a click event, events are queued while a transition
+ *        plays and replayed in order once it is over
+ * 
+ * @param FeEvent 
+ ********************************************************************************/
+void vAnim_PostEvent(TeAnim_Event FeEvent)
+{
+    if ((!stAnim_Transition.u8Active) && (u8Anim_EventHead == u8Anim_EventTail))
+    {
+        vAnim_DispatchEvent(FeEvent);
+    }
+    else if ((uint8_t)(u8Anim_EventHead - u8Anim_EventTail) < ANIM_EVENT_QUEUE_SIZE)
+    {
+        teAnim_EventQueue[u8Anim_EventHead % ANIM_EVENT_QUEUE_SIZE] = FeEvent;
+        u8Anim_EventHead++;
+    }
+}
 
-            case eAnim_eStateSubParam:
-            switch(stAnim_MasterConfig.eMode)
-            {
-                case eAnim_RunSolid:
-                break;
-
-                case eAnim_RunBlink:
-                stAnim_MasterConfig.u8BlinkRateIndex++;
-                stAnim_MasterConfig.u8BlinkRateIndex %= 3;
-                break;
-                
-                case eAnim_RunFade:
-                {
-                    stAnim_MasterConfig.u8FadeRateIndex++;
-                    stAnim_MasterConfig.u8FadeRateIndex %= 3;
-                }
-                break;
-
-                case eAnim_RunAlter:
-#if (DEVICE_MODE != DEVICE_SIMPLE)
-                case eAnim_RunGradient:
-                case eAnim_RunBicolor:
+/*********************************************************************************
+ * @brief Replay queued events until one of them starts a new transition
+ * 
+ ********************************************************************************/
+void vAnim_FlushEvents(void)
+{
+    while ((!stAnim_Transition.u8Active) && (u8Anim_EventHead != u8Anim_EventTail))
+    {
+        TeAnim_Event eEvent = teAnim_EventQueue[u8Anim_EventTail % ANIM_EVENT_QUEUE_SIZE];
+        u8Anim_EventTail++;
+        vAnim_DispatchEvent(eEvent);
+    }
+}
+
+/*********************************************************************************
+ * @brief Event handler dispatch
+ * 
+ * @param FeEvent 
+ ********************************************************************************/
+void vAnim_DispatchEvent(TeAnim_Event FeEvent)
+{
+    switch(FeEvent)
+    {
+        case eAnim_EvtShortClick:
+        vAnim_ShortClick();
+        break;
+
+        case eAnim_EvtLongClick:
+        vAnim_LongClick();
+        break;
+
+        case eAnim_EvtSubMenuClick:
+        vAnim_SubMenuClick();
+        break;
+
+        case eAnim_EvtDoubleClick:
+        vAnim_DoubleClick();
+        break;
+
+        case eAnim_EvtTripleClick:
+        vAnim_TripleClick();
+        break;
+    }
+}
+
+/*********************************************************************************
+ * @brief Long click management
+ * 
+ ********************************************************************************/
+void vAnim_LongClick(void)
+{   // used to exit menu & submenu
+    switch(eAnim_CurrentState)
+    {
+        case eAnim_StateRun:
+        eAnim_CurrentState = eAnim_StateSelect;
+        vAnim_OnEntrySelect();
+        break;
+
+        case eAnim_StateSelect:
+        eAnim_CurrentState = eAnim_StateRun;
+        vAnim_OnExitSelect();
+        break;
+
+        case eAnim_eStateSubParam:
+        eAnim_CurrentState = eAnim_StateSelect;
+        vAnim_OnExitSelect();
+        break;
+
+    }
+}
+
+/*********************************************************************************
+ * @brief Short click management, speculative: the stepped setting is saved
+ *        first so a double click can roll the click back
+ * 
+ ********************************************************************************/
+void vAnim_ShortClick(void)
+{
+    stAnim_ClickUndo.eSetting = eAnim_ClickSetting();
+    stAnim_ClickUndo.u8Value = u8Anim_GetSetting(stAnim_ClickUndo.eSetting);
+    vAnim_StepSetting(stAnim_ClickUndo.eSetting, 1);
+}
+
+/*********************************************************************************
+ * @brief Double click: undo the first click, step the same setting backwards,
+ *        whatever changed in between
+ * 
+ ********************************************************************************/
+void vAnim_DoubleClick(void)
+{
+    vAnim_SetSetting(stAnim_ClickUndo.eSetting, stAnim_ClickUndo.u8Value);
+    vAnim_StepSetting(stAnim_ClickUndo.eSetting, -1);
+}
+
+/*********************************************************************************
+ * @brief Triple click: undo the previous clicks, leave the menus
+ * 
+ ********************************************************************************/
+void vAnim_TripleClick(void)
+{
+    vAnim_SetSetting(stAnim_ClickUndo.eSetting, stAnim_ClickUndo.u8Value);
+    if (eAnim_CurrentState != eAnim_StateRun)
+    {
+        eAnim_CurrentState = eAnim_StateRun;
+        vAnim_OnExitSelect();
+    }
+}
+
+/*********************************************************************************
+ * @brief Setting a click steps in the current state
+ * 
+ * @return TeAnim_Setting 
+ ********************************************************************************/
+TeAnim_Setting eAnim_ClickSetting(void)
+{
+    switch(eAnim_CurrentState)
+    {
+        case eAnim_StateRun:
+        switch (stAnim_MasterConfig.eMode)
+        {
+            case eAnim_RunSolid:
+            case eAnim_RunBlink:
+            case eAnim_RunFade:
+            return eAnim_SetMainColor;
+
+#if (DEVICE_MODE == DEVICE_SIMPLE)
+            case eAnim_RunAlter:
+            return eAnim_SetBlinkRate;
+#else
+            case eAnim_RunEdge:
+            return eAnim_SetEdgeSize;
 #endif
-                if (stAnim_MasterConfig.u8SubMenu == 0)
-                {
-                    stAnim_MasterConfig.u8MainColorIndex++;
-                    stAnim_MasterConfig.u8MainColorIndex %= ANIM_COLOR_NB;
-                }
-                else
-                {
-                    stAnim_MasterConfig.u8SecColorIndex++;
-                    stAnim_MasterConfig.u8SecColorIndex %= ANIM_COLOR_NB;
-                }
-                break;
 
+            default:
+            return eAnim_SetNone;
+        }
+
+        case eAnim_StateSelect:
+        return eAnim_SetMode;
+
+        case eAnim_eStateSubParam:
+        switch(stAnim_MasterConfig.eMode)
+        {
+            case eAnim_RunBlink:
+            return eAnim_SetBlinkRate;
+            
+            case eAnim_RunFade:
+            return eAnim_SetFadeRate;
+
+            case eAnim_RunAlter:
 #if (DEVICE_MODE != DEVICE_SIMPLE)
-                case eAnim_RunEdge:
-                stAnim_MasterConfig.u8EdegeSize++;
-                stAnim_MasterConfig.u8EdegeSize %= 11;
-                if ((stAnim_MasterConfig.u8EdegeSize > 10) || (!stAnim_MasterConfig.u8EdegeSize))
-                { stAnim_MasterConfig.u8EdegeSize = 1; }
-                break;
+            case eAnim_RunGradient:
+            case eAnim_RunBicolor:
 #endif
+            return (stAnim_MasterConfig.u8SubMenu == 0) ? eAnim_SetMainColor : eAnim_SetSecColor;
 
-                default:
-                break;
-            }
-            break;
+#if (DEVICE_MODE != DEVICE_SIMPLE)
+            case eAnim_RunEdge:
+            return eAnim_SetEdgeSize;
+#endif
 
             default:
-            break;
+            return eAnim_SetNone;
         }
+
+        default:
+        return eAnim_SetNone;
     }
 }
 
 /*********************************************************************************
- * @brief Click tigger button
+ * @brief Value of a setting
  * 
+ * @param FeSetting 
+ * @return uint8_t 0 for eAnim_SetNone
  ********************************************************************************/
-void vAnim_CbClickSubMenu(void)
+uint8_t u8Anim_GetSetting(TeAnim_Setting FeSetting)
+{
+    switch(FeSetting)
+    {
+        case eAnim_SetMainColor:
+        return stAnim_MasterConfig.u8MainColorIndex;
+
+        case eAnim_SetSecColor:
+        return stAnim_MasterConfig.u8SecColorIndex;
+
+        case eAnim_SetBlinkRate:
+        return stAnim_MasterConfig.u8BlinkRateIndex;
+
+        case eAnim_SetFadeRate:
+        return stAnim_MasterConfig.u8FadeRateIndex;
+
+        case eAnim_SetEdgeSize:
+        return stAnim_MasterConfig.u8EdegeSize;
+
+        case eAnim_SetMode:
+        return (uint8_t)stAnim_MasterConfig.eMode;
+
+        default:
+        return 0;
+    }
+}
+
+/*********************************************************************************
+ * @brief Write a setting
+ * 
+ * @param FeSetting 
+ * @param Fu8Value 
+ ********************************************************************************/
+void vAnim_SetSetting(TeAnim_Setting FeSetting, uint8_t Fu8Value)
+{
+    switch(FeSetting)
+    {
+        case eAnim_SetMainColor:
+        stAnim_MasterConfig.u8MainColorIndex = Fu8Value;
+        break;
+
+        case eAnim_SetSecColor:
+        stAnim_MasterConfig.u8SecColorIndex = Fu8Value;
+        break;
+
+        case eAnim_SetBlinkRate:
+        stAnim_MasterConfig.u8BlinkRateIndex = Fu8Value;
+        break;
+
+        case eAnim_SetFadeRate:
+        stAnim_MasterConfig.u8FadeRateIndex = Fu8Value;
+        break;
+
+        case eAnim_SetEdgeSize:
+        stAnim_MasterConfig.u8EdegeSize = Fu8Value;
+        break;
+
+        case eAnim_SetMode:
+        stAnim_MasterConfig.eMode = (TeAnim_RunMode)Fu8Value;
+        break;
+
+        default:
+        break;
+    }
+}
+
+/*********************************************************************************
+ * @brief Move a setting one step up or down, wrapping around its range
+ * 
+ * @param FeSetting 
+ * @param Fi8Step 1 or -1
+ ********************************************************************************/
+void vAnim_StepSetting(TeAnim_Setting FeSetting, int8_t Fi8Step)
+{
+    uint8_t u8Value = u8Anim_GetSetting(FeSetting);
+
+    switch(FeSetting)
+    {
+        case eAnim_SetMainColor:
+        case eAnim_SetSecColor:
+        u8Value = u8Anim_Wrap(u8Value, Fi8Step, ANIM_COLOR_NB);
+        break;
+
+        case eAnim_SetBlinkRate:
+        case eAnim_SetFadeRate:
+        u8Value = u8Anim_Wrap(u8Value, Fi8Step, 3);
+        break;
+
+        case eAnim_SetEdgeSize:
+        u8Value = 1 + u8Anim_Wrap(u8Value - 1, Fi8Step, 10);
+        break;
+
+        case eAnim_SetMode:
+        u8Value = u8Anim_Wrap(u8Value, Fi8Step, eAnim_NbRun);
+        break;
+
+        default:
+        return;
+    }
+    vAnim_SetSetting(FeSetting, u8Value);
+}
+
+/*********************************************************************************
+ * @brief Trigger click management
+ * 
+ ********************************************************************************/
+void vAnim_SubMenuClick(void)
 {   // callback attached to BUTTON pin, manage submenu nav
     if (eAnim_CurrentState == eAnim_StateSelect)
     {
@@ -707,32 +1299,76 @@ void vAnim_CbClickSubMenu(void)
 }
 
 /*********************************************************************************
- * @brief 
+ * @brief Current menu state and settings
+ * 
+ * @param FpstSnapshot 
+ * @return uint8_t 1 when no transition plays and no click event is queued
+ ********************************************************************************/
+uint8_t u8Anim_GetSnapshot(TstAnim_Snapshot* FpstSnapshot)
+{
+    FpstSnapshot->stConfig = stAnim_MasterConfig;
+    FpstSnapshot->eState = eAnim_CurrentState;
+    return !stAnim_Transition.u8Active && (u8Anim_EventHead == u8Anim_EventTail);
+}
+
+/*********************************************************************************
+ * @brief Menu entry flash
+ * 
+ ********************************************************************************/
+void vAnim_OnEntrySelect(void)
+{
+    stAnim_Transition.rgbColor = CRGB::Blue;
+    stAnim_Transition.u8Active = 1;
+    vAnim_RestartFrames();
+}
+
+/*********************************************************************************
+ * @brief Menu exit flash
+ * 
+ ********************************************************************************/
+void vAnim_OnExitSelect(void)
+{
+    stAnim_Transition.rgbColor = CRGB::Green;
+    stAnim_Transition.u8Active = 1;
+    vAnim_RestartFrames();
+}
+
+/*********************************************************************************
+ * @brief Play the scheduled menu transition, color then black
  * 
  * @param FpLeds 
+ * @param FpstFrame 
  ********************************************************************************/
-void vAnim_OnEntrySelect(CRGB* FpLeds)
+void vAnim_RunTransition(CRGB* FpLeds, const TstAnim_Frame* FpstFrame)
 {
-    fill_solid(FpLeds, NB_PIXELS, CRGB::Blue);
-    FastLED.show();
-    delay(500);
-    FastLED.clear();
-    FastLED.show();
+    if (FpstFrame->u32Index == 0)
+    {
+        vAnim_Fill(FpLeds, stAnim_Transition.rgbColor);
+        u8Anim_Show(FpLeds);
+    }
+    else if (FpstFrame->u32Elapsed >= TIME_MENU_TRANSITION)
+    {
+        vAnim_Clear(FpLeds);
+        u8Anim_Show(FpLeds);
+        stAnim_Transition.u8Active = 0;
+        vAnim_FlushEvents();
+    }
 }
 
 /*********************************************************************************
+ * @brief Mode selection menu
  * 
+ * @param FpLeds 
+ * @param FpstFrame 
  ********************************************************************************/
-void vAnim_OnExitSelect(CRGB* FpLeds)
+void vAnim_MenuSelect(CRGB* FpLeds, const TstAnim_Frame* FpstFrame)
 {
-    fill_solid(FpLeds, NB_PIXELS, CRGB::Green);
-    FastLED.show();
-    delay(500);
-    FastLED.clear();
-    FastLED.show();
+    if (TstAnim_Device::bStrip)
+    { vAnim_MenuStripDisplay(FpLeds, CRGB::Red, stAnim_MasterConfig.eMode + 1); }
+    else
+    { vAnim_MenuBlink(FpLeds, FpstFrame, CRGB::Blue, stAnim_MasterConfig.eMode + 1); }
 }
 
-#if (DEVICE_MODE != DEVICE_SIMPLE)
 /*********************************************************************************
  * @brief Display number sector, 1 red each 4 pixels
  * 
@@ -742,41 +1378,33 @@ void vAnim_OnExitSelect(CRGB* FpLeds)
  ********************************************************************************/
 void vAnim_MenuStripDisplay(CRGB* FpLeds, CRGB FSetColor, uint8_t Fu8Index)
 {
-    static uint32_t su32timeout = 0;
-    if (millis() > su32timeout)
+    vAnim_Clear(FpLeds);
+    for (uint8_t i = 0; (i < Fu8Index) && ((i * 4) < NB_PIXELS); i++)
     {
-        su32timeout = millis() + REFRESH_TIMEOUT;
-        FastLED.clear();
-        for (uint8_t i = 0; i < Fu8Index; i++)
-        {
-            FpLeds[i*4] = FSetColor;
-        }
-        FastLED.show();
+        FpLeds[i*4] = FSetColor;
     }
+    u8Anim_Show(FpLeds);
 }
-#endif
 
 /*********************************************************************************
- * @brief Blink every seconds with repeat
+ * @brief Blink every seconds with repeat, driven by the frame time so it
+ *        needs eAnim_RateMenu (one frame per on/off slot)
  * 
  * @param FpLeds 
+ * @param FpstFrame 
  * @param FSetColor 
  * @param Fu8Repeat 
  ********************************************************************************/
-void vAnim_MenuBlink(CRGB* FpLeds, CRGB FSetColor, uint8_t Fu8Repeat)
+void vAnim_MenuBlink(CRGB* FpLeds, const TstAnim_Frame* FpstFrame, CRGB FSetColor, uint8_t Fu8Repeat)
 {
-    static uint32_t su32timeout = 0;
-    if (millis() > su32timeout)
+    uint32_t u32Sequence = (uint32_t)Fu8Repeat * (TIME_MENU_BLINK_ON + TIME_MENU_BLINK_OFF);
+    uint32_t u32Loop = (u32Sequence > TIME_MENU_BLINK_LOOP) ? u32Sequence : TIME_MENU_BLINK_LOOP;
+    uint32_t u32Phase = FpstFrame->u32Elapsed % u32Loop;
+
+    vAnim_Clear(FpLeds);
+    if ((u32Phase < u32Sequence) && ((u32Phase % (TIME_MENU_BLINK_ON + TIME_MENU_BLINK_OFF)) < TIME_MENU_BLINK_ON))
     {
-        su32timeout = TIME_MENU_BLINK_LOOP + millis();
-        for (uint8_t i = 0; i < Fu8Repeat; i++)
-        {
-            fill_solid(FpLeds, NB_PIXELS, FSetColor);
-            FastLED.show();
-            delay(50);
-            FastLED.clear();
-            FastLED.show();
-            delay(150);
-        }
+        vAnim_Fill(FpLeds, FSetColor);
     }
+    u8Anim_Show(FpLeds);
 }
@@ -24,5 +24,8 @@
 *********************************************************************************/
 void vAnim_Init(void);
 void vAnim_CoreMng(struct CRGB* Fptr);
+uint32_t u32Anim_GetMissedFrames(void);
+uint8_t u8Anim_IsIdle(void);
+void vAnim_OnWake(void);
 
 #endif //_ANIM_MNG_H_
@@ -6,19 +6,36 @@
  * @author your name (you@domain.com)
  */
 
+#ifndef _ANIM_MNG_INT_H_
+#define _ANIM_MNG_INT_H_
+
 /*********************************************************************************
 * Includes
 *********************************************************************************/
-#include "Config.h"
+#include "config.h"
+#include "AnimKernel.h"
 
 /*********************************************************************************
 * Types & definitions
 *********************************************************************************/
 #define REFRESH_TIMEOUT (1000/REFRESH_RATE_HZ)
-#define TIME_CLICK_DURATION_MIN     0
-#define TIME_CLICK_DURATION_MAX     500
+
+#if PRECISE_TIMING
+#define ANIM_CLOCK()        micros()
+#define ANIM_TICKS_PER_MS   1000UL
+#define ANIM_EARLY_TICKS    TIME_FRAME_SPIN_US
+#else
+#define ANIM_CLOCK()        millis()
+#define ANIM_TICKS_PER_MS   1UL
+#define ANIM_EARLY_TICKS    0
+#endif
 #define TIME_MENU_BLINK_LOOP        1000
-#define TIME_FADE_CONFIG_LOOP       2000
+#define TIME_MENU_BLINK_ON          50
+#define TIME_MENU_BLINK_OFF         150
+#define TIME_MENU_TRANSITION        500
+#define TIME_CONFIG_BLINK           300   // edited color blink in config menus
+#define ANIM_EVENT_QUEUE_SIZE       8     // power of 2
+#define ANIM_FADE_FULL              0xFF00  // 8.8 fade level of brightness 255
 #define ANIM_COLOR_NB 17
 
 typedef enum {
@@ -36,6 +53,12 @@ typedef enum {
     eAnim_RunGradient,
     eAnim_RunBicolor,
     eAnim_RunEdge,
+#endif
+#if IMG_PLAYBACK
+    eAnim_RunImage,
+#endif
+#if NET_STREAM
+    eAnim_RunStream,
 #endif
     eAnim_NbRun
 } TeAnim_RunMode;
@@ -44,47 +67,165 @@ typedef struct {
     uint8_t u8MainColorIndex;
     uint8_t u8SecColorIndex;
     uint8_t u8BlinkRateIndex;     //< refers to index ctu16BlinkRates
-    uint8_t u8FadeRateIndex;      //< refers to index ctu16FadeRates
+    uint8_t u8FadeRateIndex;      //< refers to index ctu16FadeTimes
     uint8_t u8EdegeSize;
     TeAnim_RunMode eMode;
     uint8_t u8SubMenu;
 } TstAnim_Configuration;
 
+typedef struct {
+    CRGB rgbColor;
+    uint8_t u8Active;
+} TstAnim_Transition;
+
+typedef struct {
+    TstAnim_Configuration stConfig;
+    TeAnim_State eState;
+} TstAnim_Snapshot;
+
+typedef enum {
+    eAnim_SetNone = 0,          //< a click changes nothing
+    eAnim_SetMainColor,
+    eAnim_SetSecColor,
+    eAnim_SetBlinkRate,
+    eAnim_SetFadeRate,
+    eAnim_SetEdgeSize,
+    eAnim_SetMode
+} TeAnim_Setting;
+
+typedef struct {
+    TeAnim_Setting eSetting;    //< stepped by the speculative single click
+    uint8_t u8Value;            //< its value before
+} TstAnim_ClickUndo;
+
+typedef struct {
+    uint32_t u32Index;      //< frames rendered since the renderer became active
+    uint32_t u32Elapsed;    //< ms since frame 0
+    uint16_t u16DeltaMs;    //< ms since previous frame
+} TstAnim_Frame;
+
+typedef enum {
+    eAnim_RateRefresh = 0,  //< REFRESH_RATE_HZ
+    eAnim_RateBlink,        //< ctu16BlinkRates[u8BlinkRateIndex]
+    eAnim_RateMenu,         //< TIME_MENU_BLINK_ON slots
+    eAnim_RateColumn,       //< IMG_COLUMN_RATE_HZ
+    eAnim_RateStream        //< NET_POLL_MS socket polls
+} TeAnim_Rate;
+
+typedef void (*pvAnim_Render)(CRGB* FpLeds, const TstAnim_Frame* FpstFrame);
+
+typedef struct {
+    pvAnim_Render pvRender;
+    TeAnim_Rate eRate;
+} TstAnim_Renderer;
+
+#if (DEVICE_MODE != DEVICE_SIMPLE)
+typedef struct {
+    uint16_t u16Start;
+    uint16_t u16Length;     //< pixels drawn
+    uint8_t u8Stride;       //< 1: contiguous, 2: every other pixel
+    CRGB rgbColor;
+} TstAnim_Span;
+
+typedef enum {
+    eAnim_BlankNone = 0,
+    eAnim_BlankMain,
+    eAnim_BlankSec
+} TeAnim_Blank;
+
+typedef struct {
+    uint8_t u8MainColorIndex;   //< 0xFF: cache empty
+    uint8_t u8SecColorIndex;
+    TeAnim_Blank eBlank;
+    CRGB trgbPixels[NB_PIXELS];
+} TstAnim_GradientCache;
+#endif
+
+typedef enum {
+    eAnim_EvtShortClick = 0,
+    eAnim_EvtLongClick,
+    eAnim_EvtSubMenuClick,
+    eAnim_EvtDoubleClick,
+    eAnim_EvtTripleClick
+} TeAnim_Event;
+
 /*********************************************************************************
 * Functions prototypes
 *********************************************************************************/
 // Callbacks
-void vAnim_CbClickFall(void);
-void vAnim_CbClickRise(void);
+void vAnim_CbClick(void);
+void vAnim_CbDoubleClick(void);
+void vAnim_CbTripleClick(void);
 void vAnim_CbLongClick(void);
-void vAnim_CbClickFall(void);
+void vAnim_CbClickSubMenu(void);
+void vAnim_CbTriggerRise(void);
+void vAnim_OnTriggerEdge(void);
+
+// Events
+void vAnim_PostEvent(TeAnim_Event FeEvent);
+void vAnim_FlushEvents(void);
+void vAnim_DispatchEvent(TeAnim_Event FeEvent);
+void vAnim_ShortClick(void);
+void vAnim_DoubleClick(void);
+void vAnim_TripleClick(void);
+TeAnim_Setting eAnim_ClickSetting(void);
+uint8_t u8Anim_GetSetting(TeAnim_Setting FeSetting);
+void vAnim_SetSetting(TeAnim_Setting FeSetting, uint8_t Fu8Value);
+void vAnim_StepSetting(TeAnim_Setting FeSetting, int8_t Fi8Step);
+void vAnim_LongClick(void);
+void vAnim_SubMenuClick(void);
+uint8_t u8Anim_GetSnapshot(TstAnim_Snapshot* FpstSnapshot);
+
+// Scheduler
+const TstAnim_Renderer* pstAnim_GetRenderer(void);
+uint16_t u16Anim_GetPeriod(TeAnim_Rate FeRate);
+void vAnim_RestartFrames(void);
+void vAnim_RestartFramesAt(uint32_t Fu32Us);
+CRGB rgbAnim_GetColor(uint8_t Fu8Index);
+uint8_t u8Anim_FadeStep(uint16_t* Fpu16Level, uint8_t Fu8Up, uint16_t Fu16DeltaMs);
+
+// Output
+uint8_t u8Anim_Show(CRGB* FpLeds);
+#if (DEVICE_MODE != DEVICE_SIMPLE)
+void vAnim_FillSpans(CRGB* FpLeds, const TstAnim_Span* FpstSpans, uint8_t Fu8Count);
+uint8_t u8Anim_EdgeSpans(TstAnim_Span* FpstSpans, CRGB FColor);
+void vAnim_FillGradient(CRGB* FpLeds, uint8_t Fu8Main, uint8_t Fu8Sec, TeAnim_Blank FeBlank);
+#endif
 
 // Animations
-void vAnim_RunSolid(CRGB* FpLeds);
-void vAnim_RunBlink(CRGB* FpLeds);
-void vAnim_RunFade(CRGB* FpLeds);
-void vAnim_RunAlternate(CRGB* FpLeds);
+void vAnim_RunSolid(CRGB* FpLeds, const TstAnim_Frame* FpstFrame);
+void vAnim_RunBlink(CRGB* FpLeds, const TstAnim_Frame* FpstFrame);
+void vAnim_RunFade(CRGB* FpLeds, const TstAnim_Frame* FpstFrame);
+void vAnim_RunAlternate(CRGB* FpLeds, const TstAnim_Frame* FpstFrame);
 #if (DEVICE_MODE != DEVICE_SIMPLE)
-void vAnim_RunGradient(CRGB* FpLeds);
-void vAnim_RunEdge(CRGB* FpLeds);    // edges are filled with secondary solor
-void vAnim_RunBicolor(CRGB* FpLeds); // split half with main and secondary color
+void vAnim_RunGradient(CRGB* FpLeds, const TstAnim_Frame* FpstFrame);
+void vAnim_RunEdge(CRGB* FpLeds, const TstAnim_Frame* FpstFrame);    // edges are filled with secondary solor
+void vAnim_RunBicolor(CRGB* FpLeds, const TstAnim_Frame* FpstFrame); // split half with main and secondary color
+#endif
+#if IMG_PLAYBACK
+void vAnim_RunImage(CRGB* FpLeds, const TstAnim_Frame* FpstFrame);   // image from flash, one column per frame
+#endif
+#if NET_STREAM
+void vAnim_RunStream(CRGB* FpLeds, const TstAnim_Frame* FpstFrame);  // frames received over UDP, shown on arrival
 #endif
 
 // Configurations
-void vAnim_ConfigBlink(CRGB* FpLeds);
-void vAnim_ConfigFade(CRGB* FpLeds);
+void vAnim_ConfigNone(CRGB* FpLeds, const TstAnim_Frame* FpstFrame);
+void vAnim_ConfigBlink(CRGB* FpLeds, const TstAnim_Frame* FpstFrame);
+void vAnim_ConfigFade(CRGB* FpLeds, const TstAnim_Frame* FpstFrame);
+void vAnim_ConfigAlternate(CRGB* FpLeds, const TstAnim_Frame* FpstFrame);
 #if (DEVICE_MODE != DEVICE_SIMPLE)
-void vAnim_ConfigGradient(CRGB* FpLeds);
-void vAnim_ConfigBicolor(CRGB* FpLeds);
-void vAnim_ConfigEdge(CRGB* FpLeds);
-void vAnim_ConfigAlternate(CRGB* FpLeds);
+void vAnim_ConfigGradient(CRGB* FpLeds, const TstAnim_Frame* FpstFrame);
+void vAnim_ConfigBicolor(CRGB* FpLeds, const TstAnim_Frame* FpstFrame);
+void vAnim_ConfigEdge(CRGB* FpLeds, const TstAnim_Frame* FpstFrame);
 #endif
 
 // Menu utils
-void vAnim_OnEntrySelect(CRGB* FpLeds);
-void vAnim_OnExitSelect(CRGB* FpLeds);
-void vAnim_CbClickSubMenu(void);
-void vAnim_MenuBlink(CRGB* FpLeds, CRGB FSetColor, uint8_t Fu8Repeat);
-#if (DEVICE_MODE != DEVICE_SIMPLE)
+void vAnim_OnEntrySelect(void);
+void vAnim_OnExitSelect(void);
+void vAnim_RunTransition(CRGB* FpLeds, const TstAnim_Frame* FpstFrame);
+void vAnim_MenuSelect(CRGB* FpLeds, const TstAnim_Frame* FpstFrame);
+void vAnim_MenuBlink(CRGB* FpLeds, const TstAnim_Frame* FpstFrame, CRGB FSetColor, uint8_t Fu8Repeat);
 void vAnim_MenuStripDisplay(CRGB* FpLeds, CRGB FSetColor, uint8_t Fu8Index);
-#endif
+
+#endif //_ANIM_MNG_INT_H_
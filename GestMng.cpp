@@ -0,0 +1,145 @@
+/**
+ * @brief Button gesture recognizer
+ * @file GestMng.cpp
+ * @version 0.1
+ * @date 2026-10-17
+ * @author Nello (nello.chom@protonmail.com)
+ *
+ * Fed by the debouncer with every committed edge and its time, in order, so
+ * a press and release replayed from the same drain of the edge queue (loop()
+ * stalled) are still a click. vGest_Manager only times the holds. Nothing
+ * waits for the double click window: a click is sent as soon as the button
+ * is released, a following click upgrades it.
+ */
+
+/*********************************************************************************
+* Includes
+*********************************************************************************/
+#include <Arduino.h>
+#include "GestMng.h"
+
+/*********************************************************************************
+* Types & definitions
+*********************************************************************************/
+#define GEST_MAX_CLICKS     3
+
+typedef struct {
+    uint8_t u8Pressed;          // debounced level after the last edge
+    uint8_t u8Clicks;           // clicks in the current sequence
+    uint8_t u8Holds;            // hold events sent for the current press
+    uint32_t u32PressTime;      // us
+    uint32_t u32ReleaseTime;    // us, last click release
+    uint32_t u32HoldTime;       // us, press or last hold event
+} TstGest_Input;
+
+/*********************************************************************************
+* Global variables
+*********************************************************************************/
+static TstGest_Input tstGest_Inputs[eUtils_NbInput];
+static pvEdgeCallback txGest_Callbacks[eUtils_NbInput][eGest_NbEvent];
+
+/*********************************************************************************
+* Internal functions
+*********************************************************************************/
+
+/*********************************************************************************
+ * @brief Fire the callback of one gesture
+ *
+ * @param FeInput
+ * @param FeEvent
+ ********************************************************************************/
+static void vGest_Dispatch(TeUtils_BtnType FeInput, TeGest_Event FeEvent)
+{
+    if (txGest_Callbacks[FeInput][FeEvent] != NULL)
+    { txGest_Callbacks[FeInput][FeEvent](); }
+}
+
+/*********************************************************************************
+ * @brief Debounced edge of one input, edge listener of the debouncer
+ *
+ * @param FeInput
+ * @param FeEdge
+ * @param Fu32EdgeTime micros() of the pin change
+ ********************************************************************************/
+static void vGest_OnEdge(TeUtils_BtnType FeInput, TeUtils_Edge FeEdge, uint32_t Fu32EdgeTime)
+{
+    TstGest_Input* pstInput = &tstGest_Inputs[FeInput];
+
+    pstInput->u8Pressed = (FeEdge == eUtils_Falling);   // active LOW
+    if (pstInput->u8Pressed)
+    {
+        if (pstInput->u8Clicks && ((Fu32EdgeTime - pstInput->u32ReleaseTime) > (TIME_DOUBLE_CLICK * 1000UL)))
+        { pstInput->u8Clicks = 0; }  // too late, new sequence
+        pstInput->u32PressTime = Fu32EdgeTime;
+        pstInput->u32HoldTime = Fu32EdgeTime;
+        pstInput->u8Holds = 0;
+    }
+    else if (!pstInput->u8Holds && ((Fu32EdgeTime - pstInput->u32PressTime) < (TIME_CLICK_MAX * 1000UL)))
+    {
+        pstInput->u32ReleaseTime = Fu32EdgeTime;
+        vGest_Dispatch(FeInput, (TeGest_Event)(eGest_Click + pstInput->u8Clicks));
+        pstInput->u8Clicks = (pstInput->u8Clicks + 1) % GEST_MAX_CLICKS;
+    }
+    else
+    {   // too long for a click, a hold only seen at release (loop() stalled) is still sent
+        if (!pstInput->u8Holds && ((Fu32EdgeTime - pstInput->u32HoldTime) > (TIME_LONG_PUSH * 1000UL)))
+        { vGest_Dispatch(FeInput, eGest_Hold); }
+        pstInput->u8Clicks = 0;
+    }
+}
+
+/*********************************************************************************
+* External functions
+*********************************************************************************/
+
+/*********************************************************************************
+ * @brief Start from the current button levels
+ *
+ ********************************************************************************/
+void vGest_Init(void)
+{
+    memset((void*)tstGest_Inputs, 0, sizeof(tstGest_Inputs));
+    for (uint8_t u8Input = 0; u8Input < eUtils_NbInput; u8Input++)
+    {
+        tstGest_Inputs[u8Input].u8Pressed = (eUtils_GetButtonState((TeUtils_BtnType)u8Input) == eUtils_Active);
+        tstGest_Inputs[u8Input].u8Holds = tstGest_Inputs[u8Input].u8Pressed;    // no click for a press older than us
+        tstGest_Inputs[u8Input].u32HoldTime = micros();
+    }
+    vUtils_SetEdgeListener(vGest_OnEdge);
+}
+
+/*********************************************************************************
+ * @brief Setup a gesture callback
+ *
+ * @param FeInput
+ * @param FeEvent
+ * @param xCallback NULL to remove
+ ********************************************************************************/
+void vGest_SetCallback(TeUtils_BtnType FeInput, TeGest_Event FeEvent, pvEdgeCallback xCallback)
+{
+    if ((FeInput < eUtils_NbInput) && (FeEvent < eGest_NbEvent))
+    { txGest_Callbacks[FeInput][FeEvent] = xCallback; }
+}
+
+/*********************************************************************************
+ * @brief Hold events of the pressed inputs, call after vUtils_ButtonManager
+ *
+ ********************************************************************************/
+void vGest_Manager(void)
+{
+    uint32_t u32Now = micros();
+
+    for (uint8_t u8Input = 0; u8Input < eUtils_NbInput; u8Input++)
+    {
+        TeUtils_BtnType eInput = (TeUtils_BtnType)u8Input;
+        TstGest_Input* pstInput = &tstGest_Inputs[u8Input];
+
+        if (pstInput->u8Pressed && ((u32Now - pstInput->u32HoldTime) > (TIME_LONG_PUSH * 1000UL)))
+        {
+            vGest_Dispatch(eInput, pstInput->u8Holds ? eGest_HoldRepeat : eGest_Hold);
+            pstInput->u32HoldTime = u32Now;     // will loop at [TIME_LONG_PUSH] rate
+            pstInput->u8Holds = 1;
+            pstInput->u8Clicks = 0;
+        }
+    }
+}
@@ -0,0 +1,43 @@
+/**
+ * @brief Button gesture recognizer
+ * @file GestMng.h
+ * @version 0.1
+ * @date 2026-10-17
+ * @author Nello (nello.chom@protonmail.com)
+ */
+
+#ifndef _GEST_MNG_H_
+#define _GEST_MNG_H_
+
+/*********************************************************************************
+* Includes
+*********************************************************************************/
+#include "config.h"
+#include "utils.h"
+
+/*********************************************************************************
+* Types & definitions
+*********************************************************************************/
+/**
+ * Clicks are sent speculatively on release: eGest_Click for the first one
+ * of a sequence, eGest_DoubleClick / eGest_TripleClick when the next ones
+ * start within TIME_DOUBLE_CLICK. A double (triple) click replaces the
+ * actions of the clicks before it in the sequence, the consumer undoes them.
+ */
+typedef enum {
+    eGest_Click = 0,
+    eGest_DoubleClick,
+    eGest_TripleClick,
+    eGest_Hold,         ///< held for TIME_LONG_PUSH, no click on release
+    eGest_HoldRepeat,   ///< every TIME_LONG_PUSH after eGest_Hold
+    eGest_NbEvent
+} TeGest_Event;
+
+/*********************************************************************************
+* External functions
+*********************************************************************************/
+void vGest_Init(void);
+void vGest_SetCallback(TeUtils_BtnType FeInput, TeGest_Event FeEvent, pvEdgeCallback xCallback);
+void vGest_Manager(void);
+
+#endif //_GEST_MNG_H_
@@ -0,0 +1,396 @@
+/**
+ * @brief Light painting image playback, streamed from flash
+ * @file ImgMng.cpp
+ * @version 0.1
+ * @date 2026-10-17
+ * @author Nello (nello.chom@protonmail.com)
+ *
+ * Two buffers hold encoded columns: the renderer decodes the front one
+ * straight into the frame buffer, then vImg_Prefetch reads the following
+ * column into the back buffer, vImg_Seek swaps them when it comes. The file read happens after the
+ * frame went out, in the slack of the column period, so the column rate does
+ * not depend on the flash access time and only two columns of the image are
+ * ever in RAM.
+ *
+ * Palette images keep IMG_INDEX_CACHE entries of the column index in RAM, a
+ * sequential playback reads the index once every IMG_INDEX_CACHE columns.
+ */
+
+/*********************************************************************************
+* Includes
+*********************************************************************************/
+#include <FastLED.h>
+#include "ImgMng.h"
+
+#if IMG_PLAYBACK
+#include <LittleFS.h>
+
+/*********************************************************************************
+* Types & definitions
+*********************************************************************************/
+#define IMG_NO_COLUMN       0xFFFF
+#define IMG_NO_POS          0xFFFFFFFF
+#define IMG_COLUMN_BYTES    (NB_PIXELS * 3)     // a raw column, the worst case RLE column of NB_PIXELS pixels is shorter
+#define IMG_INDEX_CACHE     16
+
+typedef enum {
+    eImg_Raw = 0,
+    eImg_Pal4,
+    eImg_Pal8
+} TeImg_Format;
+
+/*********************************************************************************
+* Internal functions prototypes
+*********************************************************************************/
+static uint8_t u8Img_ReadHeader(void);
+static uint8_t u8Img_Locate(uint16_t Fu16Column, uint32_t* Fpu32Pos, uint16_t* Fpu16Len);
+static void vImg_Load(uint8_t Fu8Buffer, uint16_t Fu16Column);
+static void vImg_DecodeRle(CRGB* FpLeds, const uint8_t* Fpu8Data, uint16_t Fu16Len);
+
+/*********************************************************************************
+* Global variables
+*********************************************************************************/
+static File xImg_File;
+static uint8_t u8Img_Ready = 0;
+static TeImg_Format eImg_Format = eImg_Raw;
+static uint16_t u16Img_Width = 0;
+static uint16_t u16Img_Height = 0;
+static uint32_t u32Img_FileSize = 0;
+
+static CRGB trgbImg_Palette[256];
+static uint32_t u32Img_IndexPos = 0;        // file offset of the column index
+static uint16_t u16Img_IndexBase = IMG_NO_COLUMN;
+static uint32_t tu32Img_Index[IMG_INDEX_CACHE + 1];  // offsets of columns u16Img_IndexBase..+IMG_INDEX_CACHE
+
+static uint8_t tu8Img_Columns[2][IMG_COLUMN_BYTES];
+static uint16_t tu16Img_Length[2];
+static uint16_t tu16Img_Loaded[2] = {IMG_NO_COLUMN, IMG_NO_COLUMN};    // column held by each buffer
+static uint8_t u8Img_Front = 0;
+static uint16_t u16Img_Column = 0;       // column in the front buffer
+static uint32_t u32Img_FilePos = 0;
+
+/*********************************************************************************
+* External functions
+*********************************************************************************/
+
+/*********************************************************************************
+ * @brief Mount the file system, open IMG_PATH and load its first columns
+ *
+ * @return uint8_t 1 when an image is ready to play
+ ********************************************************************************/
+uint8_t u8Img_Init(void)
+{
+    u8Img_Ready = 0;
+    if (xImg_File)
+    { xImg_File.close(); }
+    if (!LittleFS.begin())
+    { return 0; }
+    xImg_File = LittleFS.open(IMG_PATH, "r");
+    if (!xImg_File)
+    { return 0; }
+
+    if (!u8Img_ReadHeader())
+    {
+        xImg_File.close();
+        return 0;
+    }
+
+    u8Img_Ready = 1;
+    u16Img_IndexBase = IMG_NO_COLUMN;
+    tu16Img_Loaded[0] = IMG_NO_COLUMN;
+    tu16Img_Loaded[1] = IMG_NO_COLUMN;
+    vImg_Rewind();
+    return 1;
+}
+
+/*********************************************************************************
+ * @brief An image is open
+ *
+ * @return uint8_t
+ ********************************************************************************/
+uint8_t u8Img_IsReady(void)
+{
+    return u8Img_Ready;
+}
+
+/*********************************************************************************
+ * @brief Number of columns of the image
+ *
+ * @return uint16_t
+ ********************************************************************************/
+uint16_t u16Img_GetWidth(void)
+{
+    return u16Img_Width;
+}
+
+/*********************************************************************************
+ * @brief Index of the column drawn by vImg_GetColumn, u16Img_GetWidth() once
+ *        the image is over
+ *
+ * @return uint16_t
+ ********************************************************************************/
+uint16_t u16Img_GetColumn(void)
+{
+    return u16Img_Column;
+}
+
+/*********************************************************************************
+ * @brief Decode the current column into the frame buffer, NB_PIXELS pixels
+ *        (image cropped or padded with black)
+ *
+ * @param FpLeds
+ ********************************************************************************/
+void vImg_GetColumn(CRGB* FpLeds)
+{
+    const uint8_t* pu8Data = tu8Img_Columns[u8Img_Front];
+    uint16_t u16Len = tu16Img_Length[u8Img_Front];
+
+    if (eImg_Format == eImg_Raw)
+    {
+        memcpy((void*)FpLeds, pu8Data, u16Len);
+        memset((uint8_t*)FpLeds + u16Len, 0, IMG_COLUMN_BYTES - u16Len);
+    }
+    else
+    { vImg_DecodeRle(FpLeds, pu8Data, u16Len); }
+}
+
+/*********************************************************************************
+ * @brief Read the column after the current one into the back buffer, the
+ *        next vImg_Seek to it only swaps the buffers
+ *
+ ********************************************************************************/
+void vImg_Prefetch(void)
+{
+    if (!u8Img_Ready || (u16Img_Column >= u16Img_Width))
+    { return; }
+
+    if (tu16Img_Loaded[u8Img_Front ^ 1] != (u16Img_Column + 1))
+    { vImg_Load(u8Img_Front ^ 1, u16Img_Column + 1); }
+}
+
+/*********************************************************************************
+ * @brief Make a column the current one: swap the buffers when it is the
+ *        prefetched one, read it now otherwise
+ *
+ * @param Fu16Column
+ ********************************************************************************/
+void vImg_Seek(uint16_t Fu16Column)
+{
+    if (!u8Img_Ready || (Fu16Column == u16Img_Column))
+    { return; }
+
+    if (Fu16Column > u16Img_Width)
+    { Fu16Column = u16Img_Width; }
+    u16Img_Column = Fu16Column;
+    if (tu16Img_Loaded[u8Img_Front ^ 1] == Fu16Column)
+    { u8Img_Front ^= 1; }
+    else if (tu16Img_Loaded[u8Img_Front] != Fu16Column)
+    { vImg_Load(u8Img_Front, Fu16Column); }
+}
+
+/*********************************************************************************
+ * @brief Back to the first column, both buffers loaded
+ *
+ ********************************************************************************/
+void vImg_Rewind(void)
+{
+    if (!u8Img_Ready)
+    { return; }
+
+    u16Img_Column = 0;
+    if (tu16Img_Loaded[u8Img_Front] != 0)
+    { vImg_Load(u8Img_Front, 0); }
+    if (tu16Img_Loaded[u8Img_Front ^ 1] != 1)
+    { vImg_Load(u8Img_Front ^ 1, 1); }
+}
+
+/*********************************************************************************
+* Internal functions
+*********************************************************************************/
+
+/*********************************************************************************
+ * @brief Read and check the header, the palette of LPI1 files
+ *
+ * @return uint8_t 1 when the file can be played
+ ********************************************************************************/
+static uint8_t u8Img_ReadHeader(void)
+{
+    uint8_t tu8Header[IMG_PAL_HEADER_SIZE];
+    uint32_t u32DataPos;
+    uint16_t u16Colors;
+
+    u32Img_FileSize = xImg_File.size();
+    if (xImg_File.read(tu8Header, IMG_HEADER_SIZE) != IMG_HEADER_SIZE)
+    { return 0; }
+    u16Img_Width = tu8Header[4] | (tu8Header[5] << 8);
+    u16Img_Height = tu8Header[6] | (tu8Header[7] << 8);
+    u32Img_FilePos = IMG_HEADER_SIZE;
+    if ((u16Img_Width == 0) || (u16Img_Width == IMG_NO_COLUMN) || (u16Img_Height == 0))
+    { return 0; }
+
+    if (memcmp(tu8Header, IMG_MAGIC_RAW, IMG_MAGIC_SIZE) == 0)
+    {
+        eImg_Format = eImg_Raw;
+        return (u32Img_FileSize >= (IMG_HEADER_SIZE + (uint32_t)u16Img_Width * u16Img_Height * 3));
+    }
+    if (memcmp(tu8Header, IMG_MAGIC_PAL, IMG_MAGIC_SIZE) != 0)
+    { return 0; }
+
+    if (xImg_File.read(&tu8Header[IMG_HEADER_SIZE], IMG_PAL_HEADER_SIZE - IMG_HEADER_SIZE) != (IMG_PAL_HEADER_SIZE - IMG_HEADER_SIZE))
+    { return 0; }
+    u16Colors = tu8Header[9] + 1;
+    if (tu8Header[8] == 4)
+    { eImg_Format = eImg_Pal4; }
+    else if (tu8Header[8] == 8)
+    { eImg_Format = eImg_Pal8; }
+    else
+    { return 0; }
+    if ((eImg_Format == eImg_Pal4) && (u16Colors > 16))
+    { return 0; }
+
+    memset((void*)trgbImg_Palette, 0, sizeof(trgbImg_Palette));     // indices past the palette are black
+    if (xImg_File.read((uint8_t*)trgbImg_Palette, u16Colors * 3) != (size_t)(u16Colors * 3))
+    { return 0; }
+    u32Img_IndexPos = IMG_PAL_HEADER_SIZE + (u16Colors * 3);
+    u32DataPos = u32Img_IndexPos + (((uint32_t)u16Img_Width + 1) * 4);
+    u32Img_FilePos = u32Img_IndexPos;
+    return (u32Img_FileSize >= u32DataPos);
+}
+
+/*********************************************************************************
+ * @brief Where the encoded column starts and how much of it to read
+ *
+ * @param Fu16Column < u16Img_Width
+ * @param Fpu32Pos file offset
+ * @param Fpu16Len bytes, at most IMG_COLUMN_BYTES
+ * @return uint8_t 0 when the index can not be read
+ ********************************************************************************/
+static uint8_t u8Img_Locate(uint16_t Fu16Column, uint32_t* Fpu32Pos, uint16_t* Fpu16Len)
+{
+    uint32_t u32End;
+
+    if (eImg_Format == eImg_Raw)
+    {
+        *Fpu32Pos = IMG_HEADER_SIZE + ((uint32_t)Fu16Column * u16Img_Height * 3);
+        *Fpu16Len = ((u16Img_Height < NB_PIXELS) ? u16Img_Height : NB_PIXELS) * 3;
+        return 1;
+    }
+
+    if ((u16Img_IndexBase == IMG_NO_COLUMN) || (Fu16Column < u16Img_IndexBase) || (Fu16Column >= (u16Img_IndexBase + IMG_INDEX_CACHE)))
+    {
+        uint16_t u16Entries = u16Img_Width - Fu16Column;
+        uint8_t tu8Raw[(IMG_INDEX_CACHE + 1) * 4];
+
+        if (u16Entries > IMG_INDEX_CACHE)
+        { u16Entries = IMG_INDEX_CACHE; }
+        u16Entries++;   // end of the last column
+        u16Img_IndexBase = IMG_NO_COLUMN;
+        xImg_File.seek(u32Img_IndexPos + ((uint32_t)Fu16Column * 4));
+        u32Img_FilePos = IMG_NO_POS;        // unknown until the next seek
+        if (xImg_File.read(tu8Raw, u16Entries * 4) != (size_t)(u16Entries * 4))
+        { return 0; }
+        for (uint8_t u8Entry = 0; u8Entry < u16Entries; u8Entry++)
+        {
+            tu32Img_Index[u8Entry] = tu8Raw[u8Entry * 4] | ((uint32_t)tu8Raw[(u8Entry * 4) + 1] << 8)
+                | ((uint32_t)tu8Raw[(u8Entry * 4) + 2] << 16) | ((uint32_t)tu8Raw[(u8Entry * 4) + 3] << 24);
+        }
+        u16Img_IndexBase = Fu16Column;
+        u32Img_FilePos = u32Img_IndexPos + ((uint32_t)(Fu16Column + u16Entries) * 4);
+    }
+
+    *Fpu32Pos = tu32Img_Index[Fu16Column - u16Img_IndexBase];
+    u32End = tu32Img_Index[Fu16Column - u16Img_IndexBase + 1];
+    if ((u32End < *Fpu32Pos) || (u32End > u32Img_FileSize))
+    { return 0; }
+    *Fpu16Len = ((u32End - *Fpu32Pos) < IMG_COLUMN_BYTES) ? (u32End - *Fpu32Pos) : IMG_COLUMN_BYTES;
+    return 1;
+}
+
+/*********************************************************************************
+ * @brief Read one encoded column into a buffer, past the last column it is
+ *        empty (black)
+ *
+ * @param Fu8Buffer
+ * @param Fu16Column
+ ********************************************************************************/
+static void vImg_Load(uint8_t Fu8Buffer, uint16_t Fu16Column)
+{
+    uint32_t u32Pos;
+    uint16_t u16Len;
+
+    tu16Img_Loaded[Fu8Buffer] = Fu16Column;
+    tu16Img_Length[Fu8Buffer] = 0;
+    if ((Fu16Column >= u16Img_Width) || !u8Img_Locate(Fu16Column, &u32Pos, &u16Len))
+    { return; }
+
+    if (u32Pos != u32Img_FilePos)
+    { xImg_File.seek(u32Pos); }     // index read, crop or rewind, sequential otherwise
+    tu16Img_Length[Fu8Buffer] = xImg_File.read(tu8Img_Columns[Fu8Buffer], u16Len);
+    u32Img_FilePos = u32Pos + tu16Img_Length[Fu8Buffer];
+    if (eImg_Format == eImg_Raw)
+    { tu16Img_Length[Fu8Buffer] -= tu16Img_Length[Fu8Buffer] % 3; }     // whole pixels only
+}
+
+/*********************************************************************************
+ * @brief Expand RLE packets through the palette, stops at NB_PIXELS pixels or
+ *        at the end of the data, the rest of the strip is black
+ *
+ * @param FpLeds
+ * @param Fpu8Data
+ * @param Fu16Len
+ ********************************************************************************/
+static void vImg_DecodeRle(CRGB* FpLeds, const uint8_t* Fpu8Data, uint16_t Fu16Len)
+{
+    const uint8_t* pu8End = Fpu8Data + Fu16Len;
+    uint16_t u16Pixel = 0;
+
+    while ((u16Pixel < NB_PIXELS) && (Fpu8Data < pu8End))
+    {
+        uint8_t u8Header = *Fpu8Data++;
+        uint16_t u16Count;
+
+        if (u8Header & IMG_RLE_RUN)
+        {
+            if (Fpu8Data >= pu8End)
+            { break; }
+            CRGB rgbColor = trgbImg_Palette[*Fpu8Data++];
+            u16Count = (u8Header & ~IMG_RLE_RUN) + 2;
+            if (u16Count > (NB_PIXELS - u16Pixel))
+            { u16Count = NB_PIXELS - u16Pixel; }
+            while (u16Count--)
+            { FpLeds[u16Pixel++] = rgbColor; }
+        }
+        else if (eImg_Format == eImg_Pal8)
+        {
+            u16Count = u8Header + 1;
+            if (u16Count > (pu8End - Fpu8Data))
+            { u16Count = pu8End - Fpu8Data; }
+            if (u16Count > (NB_PIXELS - u16Pixel))
+            { u16Count = NB_PIXELS - u16Pixel; }
+            while (u16Count--)
+            { FpLeds[u16Pixel++] = trgbImg_Palette[*Fpu8Data++]; }
+        }
+        else
+        {
+            u16Count = u8Header + 1;
+            if (u16Count > ((pu8End - Fpu8Data) * 2))
+            { u16Count = (pu8End - Fpu8Data) * 2; }
+            if (u16Count > (NB_PIXELS - u16Pixel))
+            { u16Count = NB_PIXELS - u16Pixel; }
+            const uint8_t* pu8Next = Fpu8Data + ((u16Count + 1) >> 1);
+            for (; u16Count >= 2; u16Count -= 2)
+            {
+                uint8_t u8Pair = *Fpu8Data++;
+                FpLeds[u16Pixel++] = trgbImg_Palette[u8Pair >> 4];
+                FpLeds[u16Pixel++] = trgbImg_Palette[u8Pair & 0x0F];
+            }
+            if (u16Count)
+            { FpLeds[u16Pixel++] = trgbImg_Palette[*Fpu8Data >> 4]; }
+            Fpu8Data = pu8Next;     // a packet cut by NB_PIXELS ends the column anyway
+        }
+    }
+
+    if (u16Pixel < NB_PIXELS)
+    { memset((void*)&FpLeds[u16Pixel], 0, sizeof(CRGB) * (NB_PIXELS - u16Pixel)); }
+}
+#endif
@@ -0,0 +1,59 @@
+/**
+ * @brief Light painting image playback, streamed from flash
+ * @file ImgMng.h
+ * @version 0.1
+ * @date 2026-10-17
+ * @author Nello (nello.chom@protonmail.com)
+ */
+
+#ifndef _IMG_MNG_H_
+#define _IMG_MNG_H_
+
+/*********************************************************************************
+* Includes
+*********************************************************************************/
+#include "config.h"
+
+/*********************************************************************************
+* Types & definitions
+*********************************************************************************/
+/**
+ * Every file starts with a 4 byte magic, then width (columns) and height
+ * (pixels per column) as uint16 little endian. Pixel 0 of a column is the
+ * first pixel of the strip.
+ *
+ * LPI0, raw: the columns one after the other, r g b bytes.
+ *
+ * LPI1, palette indexed RLE: after the common header one byte of bits per
+ * index (4 or 8), one byte of palette entries minus one, 2 reserved bytes.
+ * Then the palette (r g b), the column index (width + 1 uint32 little endian
+ * file offsets, the last one is the end of the data) and the columns. A
+ * column is a list of packets, header byte h:
+ *  - h < 0x80: h + 1 literal indices follow, a byte each or two per byte
+ *    (high nibble first) for 4 bit indices
+ *  - h >= 0x80: (h & 0x7F) + 2 times the index in the next byte
+ */
+#define IMG_MAGIC_RAW       "LPI0"
+#define IMG_MAGIC_PAL       "LPI1"
+#define IMG_MAGIC_SIZE      4
+#define IMG_HEADER_SIZE     8
+#define IMG_PAL_HEADER_SIZE 12
+#define IMG_RLE_RUN         0x80
+#define IMG_RLE_MAX_LITERAL 128
+#define IMG_RLE_MAX_RUN     129
+
+/*********************************************************************************
+* External functions
+*********************************************************************************/
+#if IMG_PLAYBACK
+uint8_t u8Img_Init(void);
+uint8_t u8Img_IsReady(void);
+uint16_t u16Img_GetWidth(void);
+uint16_t u16Img_GetColumn(void);
+void vImg_GetColumn(CRGB* FpLeds);
+void vImg_Seek(uint16_t Fu16Column);
+void vImg_Prefetch(void);
+void vImg_Rewind(void);
+#endif
+
+#endif //_IMG_MNG_H_
@@ -0,0 +1,265 @@
+/**
+ * @brief Sweep motion estimation from an accelerometer/gyro sample stream
+ * @file ImuMng.cpp
+ * @version 0.1
+ * @date 2026-10-17
+ * @author Nello (nello.chom@protonmail.com)
+ *
+ * A hand sweep is a rotation around the shoulder: the gyro rate on
+ * IMU_SWEEP_AXIS, integrated over time and scaled by IMU_SWEEP_RADIUS_MM, is
+ * the arc travelled by the pen. Accelerometer double integration drifts far
+ * too fast for a one second stroke, the accelerometer only tells when the
+ * pen is still (|a| close to 1 g) so the gyro bias can be tracked.
+ *
+ * Integer only: the travel is kept as bias corrected LSB x us in Q8, one
+ * multiply-add per sample, and converted to um when asked.
+ */
+
+/*********************************************************************************
+* Includes
+*********************************************************************************/
+#include <Arduino.h>
+#include "ImuMng.h"
+
+#if IMU_MOTION
+#if IMU_MPU6050
+#include <Wire.h>
+#endif
+
+/*********************************************************************************
+* Types & definitions
+*********************************************************************************/
+#define IMU_POLL_US             2000    // 500 Hz, a sensor read every other ms at most
+#define IMU_MAX_DT_US           20000   // longer gaps (sleep, stalled bus) count as this
+#define IMU_STILL_ACCEL_TOL     (IMU_ACCEL_LSB_PER_G / 16)
+#define IMU_STILL_GYRO_TOL      ((3L * IMU_GYRO_LSB_PER_DPS_X2 / 2) << 8)  // 3 deg/s, Q8
+#define IMU_STILL_SAMPLES       32      // still this long before the bias is tracked
+#define IMU_BIAS_SHIFT          6       // bias low pass, 1/64 per still sample
+
+// arc_um = LSB.us / (LSB_PER_DPS * 1e6) * pi / 180 * R_mm * 1000
+#define IMU_LSBUS_PER_UM        ((int64_t)(((IMU_GYRO_LSB_PER_DPS_X2 * 90000.0) / (3.14159265 * IMU_SWEEP_RADIUS_MM)) + 0.5))
+
+#if IMU_MPU6050
+#define MPU6050_ADDR            0x68
+#define MPU6050_SMPLRT_DIV      0x19
+#define MPU6050_CONFIG          0x1A
+#define MPU6050_GYRO_CONFIG     0x1B
+#define MPU6050_ACCEL_CONFIG    0x1C
+#define MPU6050_INT_STATUS      0x3A    // followed by accel, temperature and gyro, big endian
+#define MPU6050_PWR_MGMT_1      0x6B
+#define MPU6050_WHO_AM_I        0x75
+#define MPU6050_BURST_SIZE      15
+#endif
+
+/*********************************************************************************
+* Internal functions prototypes
+*********************************************************************************/
+#if IMU_MPU6050
+static uint8_t u8Imu_MpuBegin(void);
+static uint8_t u8Imu_MpuRead(TstImu_Sample* FpstSample);
+#endif
+
+/*********************************************************************************
+* Global variables
+*********************************************************************************/
+#if IMU_MPU6050
+static const TstImu_Driver cstImu_Mpu6050 = {u8Imu_MpuBegin, u8Imu_MpuRead};
+#endif
+static const TstImu_Driver* pstImu_Driver = NULL;
+static uint8_t u8Imu_Ready = 0;
+static uint8_t u8Imu_HasSample = 0;
+static uint8_t u8Imu_StillCount = 0;
+static uint32_t u32Imu_LastPoll = 0;
+static uint32_t u32Imu_LastSample = 0;
+static int32_t i32Imu_BiasQ8 = 0;       // sweep axis gyro offset, LSB Q8
+static int64_t i64Imu_Travel = 0;       // LSB.us Q8 since the stroke start, signed
+
+/*********************************************************************************
+* External functions
+*********************************************************************************/
+
+/*********************************************************************************
+ * @brief Start the configured sensor (IMU_MPU6050), none otherwise until
+ *        vImu_SetDriver
+ *
+ ********************************************************************************/
+void vImu_Init(void)
+{
+#if IMU_MPU6050
+    vImu_SetDriver(&cstImu_Mpu6050);
+#endif
+}
+
+/*********************************************************************************
+ * @brief Replace the sensor driver and start it, NULL disables motion
+ *
+ * @param FpstDriver
+ ********************************************************************************/
+void vImu_SetDriver(const TstImu_Driver* FpstDriver)
+{
+    pstImu_Driver = FpstDriver;
+    u8Imu_Ready = (FpstDriver != NULL) && FpstDriver->pu8Begin();
+    u8Imu_HasSample = 0;
+    u8Imu_StillCount = 0;
+    i64Imu_Travel = 0;
+    u32Imu_LastPoll = micros();
+}
+
+/*********************************************************************************
+ * @brief Poll the sensor every IMU_POLL_US and integrate the new sample
+ *
+ ********************************************************************************/
+void vImu_Manager(void)
+{
+    TstImu_Sample stSample;
+    uint32_t u32Now = micros();
+
+    if (!u8Imu_Ready || ((u32Now - u32Imu_LastPoll) < IMU_POLL_US))
+    { return; }
+    u32Imu_LastPoll = u32Now;
+    if (!pstImu_Driver->pu8Read(&stSample))
+    { return; }
+
+    int32_t i32RawQ8 = (int32_t)stSample.ti16Gyro[IMU_SWEEP_AXIS] << 8;
+    uint32_t u32Dt = u32Now - u32Imu_LastSample;
+    u32Imu_LastSample = u32Now;
+    if (!u8Imu_HasSample)
+    {   // first sample, assume the pen is still
+        u8Imu_HasSample = 1;
+        i32Imu_BiasQ8 = i32RawQ8;
+        return;
+    }
+    if (u32Dt > IMU_MAX_DT_US)
+    { u32Dt = IMU_MAX_DT_US; }
+
+    int32_t i32RateQ8 = i32RawQ8 - i32Imu_BiasQ8;
+    uint32_t u32AccelSq = 0;
+    for (uint8_t u8Axis = 0; u8Axis < 3; u8Axis++)
+    { u32AccelSq += (uint32_t)((int32_t)stSample.ti16Accel[u8Axis] * stSample.ti16Accel[u8Axis]); }
+
+    if ((u32AccelSq > ((uint32_t)(IMU_ACCEL_LSB_PER_G - IMU_STILL_ACCEL_TOL) * (IMU_ACCEL_LSB_PER_G - IMU_STILL_ACCEL_TOL)))
+        && (u32AccelSq < ((uint32_t)(IMU_ACCEL_LSB_PER_G + IMU_STILL_ACCEL_TOL) * (IMU_ACCEL_LSB_PER_G + IMU_STILL_ACCEL_TOL)))
+        && (i32RateQ8 > -IMU_STILL_GYRO_TOL) && (i32RateQ8 < IMU_STILL_GYRO_TOL))
+    {
+        if (u8Imu_StillCount < IMU_STILL_SAMPLES)
+        { u8Imu_StillCount++; }
+        else
+        { i32Imu_BiasQ8 += i32RateQ8 >> IMU_BIAS_SHIFT; }
+    }
+    else
+    { u8Imu_StillCount = 0; }
+
+    i64Imu_Travel += (int64_t)i32RateQ8 * u32Dt;
+}
+
+/*********************************************************************************
+ * @brief A sensor answered
+ *
+ * @return uint8_t
+ ********************************************************************************/
+uint8_t u8Imu_IsReady(void)
+{
+    return u8Imu_Ready;
+}
+
+/*********************************************************************************
+ * @brief Start a new stroke, travel back to 0
+ *
+ ********************************************************************************/
+void vImu_ResetStroke(void)
+{
+    i64Imu_Travel = 0;
+}
+
+/*********************************************************************************
+ * @brief Distance from the stroke start along the sweep, whatever the sweep
+ *        direction (sweeping back brings it down again)
+ *
+ * @return uint32_t um
+ ********************************************************************************/
+uint32_t u32Imu_GetTravelUm(void)
+{
+    int64_t i64Travel = (i64Imu_Travel < 0) ? -i64Imu_Travel : i64Imu_Travel;
+    return (uint32_t)(i64Travel / (IMU_LSBUS_PER_UM << 8));
+}
+
+/*********************************************************************************
+* Internal functions
+*********************************************************************************/
+#if IMU_MPU6050
+/*********************************************************************************
+ * @brief Write one MPU6050 register
+ *
+ * @param Fu8Reg
+ * @param Fu8Value
+ * @return uint8_t 1 on ACK
+ ********************************************************************************/
+static uint8_t u8Imu_MpuWrite(uint8_t Fu8Reg, uint8_t Fu8Value)
+{
+    Wire.beginTransmission(MPU6050_ADDR);
+    Wire.write(Fu8Reg);
+    Wire.write(Fu8Value);
+    return (Wire.endTransmission() == 0);
+}
+
+/*********************************************************************************
+ * @brief Read consecutive MPU6050 registers
+ *
+ * @param Fu8Reg
+ * @param Fpu8Data
+ * @param Fu8Len
+ * @return uint8_t 1 when all bytes came
+ ********************************************************************************/
+static uint8_t u8Imu_MpuReadRegs(uint8_t Fu8Reg, uint8_t* Fpu8Data, uint8_t Fu8Len)
+{
+    Wire.beginTransmission(MPU6050_ADDR);
+    Wire.write(Fu8Reg);
+    if ((Wire.endTransmission(false) != 0) || (Wire.requestFrom((uint8_t)MPU6050_ADDR, Fu8Len) != Fu8Len))
+    { return 0; }
+    for (uint8_t u8Index = 0; u8Index < Fu8Len; u8Index++)
+    { Fpu8Data[u8Index] = Wire.read(); }
+    return 1;
+}
+
+/*********************************************************************************
+ * @brief Probe the MPU6050, 500 Hz samples, 184 Hz low pass, +-2 g and
+ *        +-500 deg/s
+ *
+ * @return uint8_t 1 when present
+ ********************************************************************************/
+static uint8_t u8Imu_MpuBegin(void)
+{
+    uint8_t u8Id;
+
+    Wire.begin();
+    Wire.setClock(400000);
+    if (!u8Imu_MpuReadRegs(MPU6050_WHO_AM_I, &u8Id, 1) || (u8Id != MPU6050_ADDR))
+    { return 0; }
+    return u8Imu_MpuWrite(MPU6050_PWR_MGMT_1, 0x01)        // awake, gyro X PLL clock
+        && u8Imu_MpuWrite(MPU6050_CONFIG, 0x01)             // DLPF 184 Hz, 1 kHz gyro rate
+        && u8Imu_MpuWrite(MPU6050_SMPLRT_DIV, 1)            // 500 Hz
+        && u8Imu_MpuWrite(MPU6050_GYRO_CONFIG, 0x08)        // +-500 deg/s
+        && u8Imu_MpuWrite(MPU6050_ACCEL_CONFIG, 0x00);      // +-2 g
+}
+
+/*********************************************************************************
+ * @brief One burst from INT_STATUS, 0 until the data ready flag is set
+ *
+ * @param FpstSample
+ * @return uint8_t
+ ********************************************************************************/
+static uint8_t u8Imu_MpuRead(TstImu_Sample* FpstSample)
+{
+    uint8_t tu8Burst[MPU6050_BURST_SIZE];
+
+    if (!u8Imu_MpuReadRegs(MPU6050_INT_STATUS, tu8Burst, MPU6050_BURST_SIZE) || !(tu8Burst[0] & 0x01))
+    { return 0; }
+    for (uint8_t u8Axis = 0; u8Axis < 3; u8Axis++)
+    {
+        FpstSample->ti16Accel[u8Axis] = (int16_t)((tu8Burst[1 + (u8Axis * 2)] << 8) | tu8Burst[2 + (u8Axis * 2)]);
+        FpstSample->ti16Gyro[u8Axis] = (int16_t)((tu8Burst[9 + (u8Axis * 2)] << 8) | tu8Burst[10 + (u8Axis * 2)]);
+    }
+    return 1;
+}
+#endif
+#endif
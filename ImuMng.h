@@ -0,0 +1,45 @@
+/**
+ * @brief Sweep motion estimation from an accelerometer/gyro sample stream
+ * @file ImuMng.h
+ * @version 0.1
+ * @date 2026-10-17
+ * @author Nello (nello.chom@protonmail.com)
+ */
+
+#ifndef _IMU_MNG_H_
+#define _IMU_MNG_H_
+
+/*********************************************************************************
+* Includes
+*********************************************************************************/
+#include "config.h"
+
+/*********************************************************************************
+* Types & definitions
+*********************************************************************************/
+#define IMU_ACCEL_LSB_PER_G     16384   // +-2 g full scale
+#define IMU_GYRO_LSB_PER_DPS_X2 131     // +-500 dps full scale, 65.5 LSB per deg/s
+
+typedef struct {
+    int16_t ti16Accel[3];   ///< x y z, IMU_ACCEL_LSB_PER_G
+    int16_t ti16Gyro[3];    ///< x y z, IMU_GYRO_LSB_PER_DPS_X2 / 2
+} TstImu_Sample;
+
+typedef struct {
+    uint8_t (*pu8Begin)(void);                          ///< probe and configure the sensor, 1 when present
+    uint8_t (*pu8Read)(TstImu_Sample* FpstSample);      ///< 1 when a new sample was copied
+} TstImu_Driver;
+
+/*********************************************************************************
+* External functions
+*********************************************************************************/
+#if IMU_MOTION
+void vImu_Init(void);
+void vImu_SetDriver(const TstImu_Driver* FpstDriver);
+void vImu_Manager(void);
+uint8_t u8Imu_IsReady(void);
+void vImu_ResetStroke(void);
+uint32_t u32Imu_GetTravelUm(void);
+#endif
+
+#endif //_IMU_MNG_H_
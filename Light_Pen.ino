@@ -13,6 +13,11 @@
 #include "config.h"
 #include "utils.h"
 #include "AnimMng.h"
+#include "OutMng.h"
+#include "ProfMng.h"
+#include "GestMng.h"
+#include "ImuMng.h"
+#include "NetMng.h"
 #if (defined(MY_WIFI_SSID) && defined(MY_WIFI_PWD))
 #include <WiFi.h>
 const char* ssid = MY_WIFI_SSID;
@@ -27,8 +32,8 @@ void setup()
 #if (defined(MY_WIFI_SSID) && defined (MY_WIFI_PWD))
     WiFi.begin(ssid, password);
  #endif
-    pinMode(PIN_BUTTON, INPUT_PULLUP);
-    pinMode(PIN_MODE, INPUT_PULLUP);
+    vUtils_Init();
+    vGest_Init();
     FastLED.addLeds<WS2812, PIN_DATA, GRB>(MainLedStip, NB_PIXELS).setCorrection(TypicalLEDStrip);
 #if (DEVICE_MODE == DEVICE_SIMPLE)
     FastLED.setBrightness(255);
@@ -38,9 +43,34 @@ void setup()
     vAnim_Init();
     FastLED.clear();
     FastLED.show();
+    vOut_Init();
+#if IMU_MOTION
+    vImu_Init();
+#endif
+#if NET_STREAM
+    vNet_Init();
+#endif
+#if PROFILING
+    vProf_Init();
+#endif
 }
 
 void loop() {
+    PROF_LOOP();
+    PROF_START(u32ProfButtons);
     vUtils_ButtonManager();
+    PROF_STOP(eProf_Buttons, u32ProfButtons);
+    vGest_Manager();
+#if IMU_MOTION
+    vImu_Manager();
+#endif
     vAnim_CoreMng(MainLedStip);
+#if IDLE_SLEEP
+    if (u8Anim_IsIdle() && u8Utils_IsIdle())
+    {
+        vUtils_Sleep();
+        vAnim_OnWake();
+        PROF_SKIP_PERIOD();
+    }
+#endif
 }
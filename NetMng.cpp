@@ -0,0 +1,230 @@
+/**
+ * @brief Frame streaming over UDP, Art-Net ArtDmx receiver
+ * @file NetMng.cpp
+ * @version 0.1
+ * @date 2026-10-17
+ * @author Nello (nello.chom@protonmail.com)
+ *
+ * The Stream mode polls the socket every NET_POLL_MS. The pixel data of a
+ * packet is read straight into the frame buffer at the universe offset (no
+ * staging copy, CRGB is r g b like the wire format); the header is read
+ * first so stale and foreign packets are dropped before touching the frame.
+ * vOut_Submit copies the frame out, so the next packets can be decoded while
+ * the previous frame is clocked out.
+ *
+ * Sequence numbers are tracked per universe: a gap counts lost packets, a
+ * repeated or older number is a stale packet (duplicate or overtaken) and is
+ * dropped. A run of NET_STALE_RESYNC stale packets is taken as a sender
+ * restart and the sequence follows it again.
+ */
+
+/*********************************************************************************
+* Includes
+*********************************************************************************/
+#include <Arduino.h>
+#include "NetMng.h"
+
+#if NET_STREAM
+#include <WiFiUdp.h>
+
+/*********************************************************************************
+* Types & definitions
+*********************************************************************************/
+#define NET_MAX_PACKETS         (2 * NET_NB_UNIVERSES)  // per poll, a flood cannot stall loop()
+#define NET_SEQUENCE_WINDOW     127     // further ahead than this is behind (1..255 cycle)
+#define NET_STALE_RESYNC        8
+
+static_assert(sizeof(CRGB) == 3, "packets are decoded in place, CRGB must be r g b");
+
+/*********************************************************************************
+* Global variables
+*********************************************************************************/
+static WiFiUDP xNet_Udp;
+static uint8_t u8Net_Ready = 0;
+static uint8_t tu8Net_Sequence[NET_NB_UNIVERSES];   // last accepted, 0: none yet
+static uint8_t tu8Net_StaleRun[NET_NB_UNIVERSES];
+static uint8_t u8Net_FrameOpen = 0;                 // a packet of the next frame was decoded
+static uint8_t u8Net_FrameDrop = 0;                 // the open frame is not reported complete
+static uint32_t u32Net_FrameStart = 0;              // micros() of its first packet
+static uint32_t u32Net_ReadyStart = 0;              // same, for the completed frame
+static TstNet_Stats stNet_Stats;
+
+/*********************************************************************************
+* Internal functions prototypes
+*********************************************************************************/
+static uint8_t u8Net_CheckSequence(uint8_t Fu8Universe, uint8_t Fu8Sequence);
+
+/*********************************************************************************
+* External functions
+*********************************************************************************/
+
+/*********************************************************************************
+ * @brief Listen on NET_STREAM_PORT, the network does not need to be up yet
+ *
+ ********************************************************************************/
+void vNet_Init(void)
+{
+    memset(tu8Net_Sequence, 0, sizeof(tu8Net_Sequence));
+    memset(tu8Net_StaleRun, 0, sizeof(tu8Net_StaleRun));
+    vNet_ResetStats();
+    u8Net_Ready = xNet_Udp.begin(NET_STREAM_PORT);
+}
+
+/*********************************************************************************
+ * @brief The socket is open
+ *
+ * @return uint8_t
+ ********************************************************************************/
+uint8_t u8Net_IsReady(void)
+{
+    return u8Net_Ready;
+}
+
+/*********************************************************************************
+ * @brief Decode the pending packets into the frame buffer, stop as soon as a
+ *        frame is complete so it is shown before the next one overwrites it
+ *
+ * @param FpLeds frame buffer
+ * @return uint8_t 1 when FpLeds holds a new complete frame
+ ********************************************************************************/
+uint8_t u8Net_Receive(CRGB* FpLeds)
+{
+    uint8_t tu8Header[NET_ARTNET_HEADER_SIZE];
+
+    if (!u8Net_Ready)
+    { return 0; }
+
+    for (uint8_t u8Packet = 0; u8Packet < NET_MAX_PACKETS; u8Packet++)
+    {
+        int iSize = xNet_Udp.parsePacket();     // drops what is left of the previous packet
+        if (iSize <= 0)
+        { return 0; }
+
+        if ((iSize < NET_ARTNET_HEADER_SIZE) || (xNet_Udp.read(tu8Header, NET_ARTNET_HEADER_SIZE) != NET_ARTNET_HEADER_SIZE)
+            || (memcmp(tu8Header, NET_ARTNET_ID, NET_ARTNET_ID_SIZE) != 0)
+            || ((tu8Header[8] | (tu8Header[9] << 8)) != NET_ARTNET_OP_DMX))
+        {
+            stNet_Stats.u32Invalid++;
+            continue;
+        }
+
+        uint16_t u16Universe = tu8Header[14] | ((tu8Header[15] & 0x7F) << 8);
+        uint16_t u16Length = (tu8Header[16] << 8) | tu8Header[17];
+        if (((uint16_t)(u16Universe - NET_STREAM_UNIVERSE) >= NET_NB_UNIVERSES) || (u16Length > NET_ARTNET_MAX_DATA))
+        {
+            stNet_Stats.u32Invalid++;
+            continue;
+        }
+
+        uint8_t u8Universe = (uint8_t)(u16Universe - NET_STREAM_UNIVERSE);
+        if (!u8Net_CheckSequence(u8Universe, tu8Header[12]))
+        { continue; }
+
+        uint16_t u16First = (uint16_t)u8Universe * NET_UNIVERSE_PIXELS;
+        uint16_t u16Count = (uint16_t)(iSize - NET_ARTNET_HEADER_SIZE);
+        if (u16Length < u16Count)
+        { u16Count = u16Length; }
+        u16Count /= 3;
+        if (u16Count > (NB_PIXELS - u16First))
+        { u16Count = NB_PIXELS - u16First; }
+
+        if (!u8Net_FrameOpen)
+        {
+            u8Net_FrameOpen = 1;
+            u32Net_FrameStart = micros();
+        }
+        xNet_Udp.read((uint8_t*)&FpLeds[u16First], u16Count * sizeof(CRGB));
+        stNet_Stats.u32Packets++;
+
+        if (u8Universe == (NET_NB_UNIVERSES - 1))
+        {
+            u8Net_FrameOpen = 0;
+            stNet_Stats.u32Frames++;
+            if (u8Net_FrameDrop)
+            {
+                u8Net_FrameDrop = 0;
+                continue;
+            }
+            u32Net_ReadyStart = u32Net_FrameStart;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/*********************************************************************************
+ * @brief The last completed frame is latched, account its latency
+ *
+ ********************************************************************************/
+void vNet_OnShown(void)
+{
+    uint32_t u32Latency = micros() - u32Net_ReadyStart;
+
+    stNet_Stats.u32Shown++;
+    stNet_Stats.u64LatencySumUs += u32Latency;
+    if (u32Latency > stNet_Stats.u32LatencyMaxUs)
+    { stNet_Stats.u32LatencyMaxUs = u32Latency; }
+}
+
+/*********************************************************************************
+ * @brief The frame being received lost part of its pixels, do not report it
+ *        complete, the next one is
+ *
+ ********************************************************************************/
+void vNet_DropFrame(void)
+{
+    u8Net_FrameDrop = u8Net_FrameOpen;
+}
+
+/*********************************************************************************
+ * @brief Reception counters
+ *
+ * @return const TstNet_Stats*
+ ********************************************************************************/
+const TstNet_Stats* pstNet_GetStats(void)
+{
+    return &stNet_Stats;
+}
+
+/*********************************************************************************
+ * @brief Clear the reception counters
+ *
+ ********************************************************************************/
+void vNet_ResetStats(void)
+{
+    memset(&stNet_Stats, 0, sizeof(stNet_Stats));
+}
+
+/*********************************************************************************
+* Internal functions
+*********************************************************************************/
+
+/*********************************************************************************
+ * @brief Accept a packet if its sequence number is newer than the last one
+ *        of its universe, count the packets skipped in between as lost
+ *
+ * @param Fu8Universe index from NET_STREAM_UNIVERSE
+ * @param Fu8Sequence 1..255, 0 when the sender does not number packets
+ * @return uint8_t 1 when accepted
+ ********************************************************************************/
+static uint8_t u8Net_CheckSequence(uint8_t Fu8Universe, uint8_t Fu8Sequence)
+{
+    uint8_t u8Last = tu8Net_Sequence[Fu8Universe];
+
+    if ((Fu8Sequence != 0) && (u8Last != 0))
+    {
+        uint8_t u8Ahead = (uint8_t)(((uint16_t)Fu8Sequence + 255 - u8Last) % 255);
+
+        if (((u8Ahead == 0) || (u8Ahead > NET_SEQUENCE_WINDOW)) && (++tu8Net_StaleRun[Fu8Universe] < NET_STALE_RESYNC))
+        {
+            stNet_Stats.u32Stale++;
+            return 0;
+        }
+        if ((u8Ahead != 0) && (u8Ahead <= NET_SEQUENCE_WINDOW))
+        { stNet_Stats.u32Lost += u8Ahead - 1; }     // not on a resync
+    }
+    tu8Net_Sequence[Fu8Universe] = Fu8Sequence;
+    tu8Net_StaleRun[Fu8Universe] = 0;
+    return 1;
+}
+#endif
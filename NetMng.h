@@ -0,0 +1,63 @@
+/**
+ * @brief Frame streaming over UDP, Art-Net ArtDmx receiver
+ * @file NetMng.h
+ * @version 0.1
+ * @date 2026-10-17
+ * @author Nello (nello.chom@protonmail.com)
+ */
+
+#ifndef _NET_MNG_H_
+#define _NET_MNG_H_
+
+/*********************************************************************************
+* Includes
+*********************************************************************************/
+#include "config.h"
+
+/*********************************************************************************
+* Types & definitions
+*********************************************************************************/
+/**
+ * ArtDmx packet: "Art-Net\0", opcode 0x5000 (little endian), protocol
+ * version 14 (big endian), sequence (1..255, 0 when unused), physical port,
+ * universe (15 bits little endian: sub-net/universe byte then net), data
+ * length (big endian, 2..512) and the data, r g b per pixel.
+ *
+ * Pixel p is in universe NET_STREAM_UNIVERSE + p / NET_UNIVERSE_PIXELS. A
+ * frame is complete when the universe of the last pixel arrives, senders
+ * send the universes of a frame in order with the same sequence number.
+ */
+#define NET_ARTNET_ID           "Art-Net"   // 8 bytes with the terminator
+#define NET_ARTNET_ID_SIZE      8
+#define NET_ARTNET_OP_DMX       0x5000
+#define NET_ARTNET_VERSION      14
+#define NET_ARTNET_HEADER_SIZE  18
+#define NET_ARTNET_MAX_DATA     512
+#define NET_UNIVERSE_PIXELS     (NET_ARTNET_MAX_DATA / 3)
+#define NET_NB_UNIVERSES        ((NB_PIXELS + NET_UNIVERSE_PIXELS - 1) / NET_UNIVERSE_PIXELS)
+
+typedef struct {
+    uint32_t u32Packets;        ///< ArtDmx packets decoded
+    uint32_t u32Frames;         ///< frames completed
+    uint32_t u32Shown;          ///< completed frames latched on the strip
+    uint32_t u32Lost;           ///< packets missing from the sequence
+    uint32_t u32Stale;          ///< duplicate or late packets dropped
+    uint32_t u32Invalid;        ///< not ArtDmx, or a universe out of the strip
+    uint32_t u32LatencyMaxUs;   ///< first packet read to output submitted (latched, blocking output)
+    uint64_t u64LatencySumUs;   ///< over u32Shown frames
+} TstNet_Stats;
+
+/*********************************************************************************
+* External functions
+*********************************************************************************/
+#if NET_STREAM
+void vNet_Init(void);
+uint8_t u8Net_IsReady(void);
+uint8_t u8Net_Receive(CRGB* FpLeds);
+void vNet_OnShown(void);
+void vNet_DropFrame(void);
+const TstNet_Stats* pstNet_GetStats(void);
+void vNet_ResetStats(void);
+#endif
+
+#endif //_NET_MNG_H_
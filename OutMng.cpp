@@ -0,0 +1,193 @@
+/**
+ * @brief LED output driver, double buffered
+ * @file OutMng.cpp
+ * @version 0.1
+ * @date 2026-10-17
+ * @author Nello (nello.chom@protonmail.com)
+ *
+ * The caller renders into its own buffer (back buffer). vOut_Submit waits for
+ * the previous transfer, copies the frame into the front buffer and starts
+ * clocking it out, so the next frame can be rendered while the strip is fed.
+ * The front buffer is never written while a transfer reads it.
+ */
+
+/*********************************************************************************
+* Includes
+*********************************************************************************/
+#include <FastLED.h>
+#include "OutMng.h"
+#include "ProfMng.h"
+#if defined(ARDUINO_ARCH_ESP32)
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+#endif
+
+/*********************************************************************************
+* Types & definitions
+*********************************************************************************/
+#define OUT_TASK_STACK      2048
+#define OUT_TASK_PRIORITY   2
+#define OUT_TASK_CORE       0       // loop() runs on core 1
+
+/*********************************************************************************
+* Internal functions prototypes
+*********************************************************************************/
+static void vOut_SyncStart(const CRGB* FpData, uint16_t Fu16Count, uint8_t Fu8Brightness);
+static void vOut_SyncWait(void);
+static uint8_t u8Out_SyncBusy(void);
+#if defined(ARDUINO_ARCH_ESP32)
+static void vOut_Task(void* FpvParam);
+static void vOut_AsyncStart(const CRGB* FpData, uint16_t Fu16Count, uint8_t Fu8Brightness);
+static void vOut_AsyncWait(void);
+static uint8_t u8Out_AsyncBusy(void);
+#endif
+
+/*********************************************************************************
+* Global variables
+*********************************************************************************/
+static CRGB trgbOut_Front[NB_PIXELS];     // what the strip latches once the transfer ends
+
+static const TstOut_Driver cstOut_Sync = {vOut_SyncStart, vOut_SyncWait, u8Out_SyncBusy};
+#if defined(ARDUINO_ARCH_ESP32)
+static const TstOut_Driver cstOut_Async = {vOut_AsyncStart, vOut_AsyncWait, u8Out_AsyncBusy};
+static TaskHandle_t xOut_Task = NULL;
+static SemaphoreHandle_t xOut_Idle = NULL;
+static volatile uint16_t u16Out_Count = 0;
+static volatile uint8_t u8Out_Brightness = 0;
+#endif
+static const TstOut_Driver* pstOut_Driver = &cstOut_Sync;
+
+/*********************************************************************************
+* External functions
+*********************************************************************************/
+
+/*********************************************************************************
+ * @brief Clear the front buffer, start the output task when the target has one
+ * 
+ ********************************************************************************/
+void vOut_Init(void)
+{
+    memset((void*)trgbOut_Front, 0, sizeof(trgbOut_Front));
+#if defined(ARDUINO_ARCH_ESP32)
+    xOut_Idle = xSemaphoreCreateBinary();
+    if ((xOut_Idle != NULL) && (xTaskCreatePinnedToCore(vOut_Task, "LedOut", OUT_TASK_STACK, NULL,
+        OUT_TASK_PRIORITY, &xOut_Task, OUT_TASK_CORE) == pdPASS))
+    {
+        xSemaphoreGive(xOut_Idle);
+        pstOut_Driver = &cstOut_Async;
+    }
+#endif
+}
+
+/*********************************************************************************
+ * @brief Replace the output driver, NULL restores the blocking one
+ * 
+ * @param FpstDriver 
+ ********************************************************************************/
+void vOut_SetDriver(const TstOut_Driver* FpstDriver)
+{
+    pstOut_Driver->pvWait();
+    pstOut_Driver = (FpstDriver != NULL) ? FpstDriver : &cstOut_Sync;
+}
+
+/*********************************************************************************
+ * @brief Swap a frame in: the first Fu16Count pixels go to the front buffer
+ *        and are clocked out, the others keep their latched value
+ * 
+ * @param FpFrame back buffer
+ * @param Fu16Count 
+ * @param Fu8Brightness 
+ ********************************************************************************/
+void vOut_Submit(const CRGB* FpFrame, uint16_t Fu16Count, uint8_t Fu8Brightness)
+{
+    PROF_START(u32ProfShow);
+    pstOut_Driver->pvWait();
+    memcpy((void*)trgbOut_Front, FpFrame, Fu16Count * sizeof(CRGB));
+    pstOut_Driver->pvStart(trgbOut_Front, Fu16Count, Fu8Brightness);
+    PROF_STOP(eProf_Show, u32ProfShow);
+}
+
+/*********************************************************************************
+ * @brief Transfer in flight
+ * 
+ * @return uint8_t 
+ ********************************************************************************/
+uint8_t u8Out_IsBusy(void)
+{
+    return pstOut_Driver->pu8Busy();
+}
+
+/*********************************************************************************
+ * @brief Last submitted frame, what the strip shows or is about to show
+ * 
+ * @return const CRGB* 
+ ********************************************************************************/
+const CRGB* prgbOut_GetFront(void)
+{
+    return trgbOut_Front;
+}
+
+/*********************************************************************************
+* Internal functions
+*********************************************************************************/
+
+/*********************************************************************************
+ * @brief Blocking driver, FastLED returns once the frame is out
+ * 
+ ********************************************************************************/
+static void vOut_SyncStart(const CRGB* FpData, uint16_t Fu16Count, uint8_t Fu8Brightness)
+{
+    FastLED[0].show(FpData, Fu16Count, Fu8Brightness);
+}
+
+static void vOut_SyncWait(void)
+{
+}
+
+static uint8_t u8Out_SyncBusy(void)
+{
+    return 0;
+}
+
+#if defined(ARDUINO_ARCH_ESP32)
+/*********************************************************************************
+ * @brief Output task, streams the front buffer when notified and hands the
+ *        idle token back when done
+ * 
+ * @param FpvParam 
+ ********************************************************************************/
+static void vOut_Task(void* FpvParam)
+{
+    for (;;)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        FastLED[0].show(trgbOut_Front, u16Out_Count, u8Out_Brightness);
+        xSemaphoreGive(xOut_Idle);
+    }
+}
+
+/*********************************************************************************
+ * @brief Async driver, the idle token is taken at start and given back by
+ *        the task at the end of the transfer
+ * 
+ ********************************************************************************/
+static void vOut_AsyncStart(const CRGB* FpData, uint16_t Fu16Count, uint8_t Fu8Brightness)
+{
+    xSemaphoreTake(xOut_Idle, portMAX_DELAY);   // free, vOut_Submit waited for it
+    u16Out_Count = Fu16Count;
+    u8Out_Brightness = Fu8Brightness;
+    xTaskNotifyGive(xOut_Task);
+}
+
+static void vOut_AsyncWait(void)
+{
+    xSemaphoreTake(xOut_Idle, portMAX_DELAY);
+    xSemaphoreGive(xOut_Idle);
+}
+
+static uint8_t u8Out_AsyncBusy(void)
+{
+    return (uxSemaphoreGetCount(xOut_Idle) == 0);
+}
+#endif
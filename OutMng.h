@@ -0,0 +1,35 @@
+/**
+ * @brief LED output driver, double buffered
+ * @file OutMng.h
+ * @version 0.1
+ * @date 2026-10-17
+ * @author Nello (nello.chom@protonmail.com)
+ */
+
+#ifndef _OUT_MNG_H_
+#define _OUT_MNG_H_
+
+/*********************************************************************************
+* Includes
+*********************************************************************************/
+#include "config.h"
+
+/*********************************************************************************
+* Types & definitions
+*********************************************************************************/
+typedef struct {
+    void (*pvStart)(const CRGB* FpData, uint16_t Fu16Count, uint8_t Fu8Brightness); ///< start clocking out, may return before the end
+    void (*pvWait)(void);           ///< block until the previous transfer is done
+    uint8_t (*pu8Busy)(void);       ///< 1 while a transfer is in flight
+} TstOut_Driver;
+
+/*********************************************************************************
+* External functions
+*********************************************************************************/
+void vOut_Init(void);
+void vOut_SetDriver(const TstOut_Driver* FpstDriver);
+void vOut_Submit(const CRGB* FpFrame, uint16_t Fu16Count, uint8_t Fu8Brightness);
+uint8_t u8Out_IsBusy(void);
+const CRGB* prgbOut_GetFront(void);
+
+#endif //_OUT_MNG_H_
@@ -0,0 +1,398 @@
+/**
+ * @brief Frame timing instrumentation
+ * @file ProfMng.cpp
+ * @version 0.1
+ * @date 2026-10-17
+ * @author Nello (nello.chom@protonmail.com)
+ *
+ * Every probe feeds a fixed size log-linear histogram: 4 buckets per power of
+ * two, so a bucket is at most 25% wide, from 0us up to 131ms (longer samples
+ * land in the last bucket, max stays exact). Send 'p' on the serial port to
+ * dump min/p50/p99/max and the non empty buckets, 'r' to clear.
+ *
+ * The latency tracer pairs a debounced trigger edge (timestamp of the raw
+ * edge, debounce included) with the first frame handed to the output that
+ * reflects it: lit for a press, dark for a release. Stats are kept per tag,
+ * the caller passes the run mode.
+ */
+
+/*********************************************************************************
+* Includes
+*********************************************************************************/
+#include <Arduino.h>
+#include "ProfMng.h"
+
+#if PROFILING
+/*********************************************************************************
+* Types & definitions
+*********************************************************************************/
+#define PROF_SUB_BITS       2
+#define PROF_SUB            (1 << PROF_SUB_BITS)
+#define PROF_NB_BUCKETS     64
+#define PROF_DEPTH          4       // nested probes
+#define PROF_BAUDRATE       115200
+
+typedef struct {
+    uint32_t u32Count;
+    uint32_t u32Min;
+    uint32_t u32Max;
+    uint16_t tu16Buckets[PROF_NB_BUCKETS];
+} TstProf_Histogram;
+
+/*********************************************************************************
+* Internal functions prototypes
+*********************************************************************************/
+static uint8_t u8Prof_Bucket(uint32_t Fu32Us);
+static uint32_t u32Prof_BucketLow(uint8_t Fu8Bucket);
+static uint32_t u32Prof_Percentile(const TstProf_Histogram* FpstHisto, uint8_t Fu8Percent);
+static void vProf_PrintField(uint32_t Fu32Value, uint8_t Fu8Width);
+static void vProf_AddLatency(TstProf_Latency* FpstLatency, uint32_t Fu32Us);
+
+/*********************************************************************************
+* Global variables
+*********************************************************************************/
+static TstProf_Histogram tstProf_Histo[eProf_NbProbe];
+static const char* const tpcProf_Names[eProf_NbProbe] = {"render", "show", "slot", "period", "buttons"};
+
+static uint32_t tu32Prof_Child[PROF_DEPTH + 1];     // nested time per open probe
+static uint8_t u8Prof_Depth = 0;
+static uint32_t u32Prof_LoopStart = 0;
+static uint8_t u8Prof_LoopValid = 0;
+
+static TstProf_Latency tstProf_Latency[PROF_NB_TAGS][2];   // [tag][release, press]
+static uint32_t u32Prof_EdgeUs = 0;
+static uint8_t u8Prof_EdgePress = 0;
+static uint8_t u8Prof_EdgePending = 0;
+
+/*********************************************************************************
+* External functions
+*********************************************************************************/
+
+/*********************************************************************************
+ * @brief Open the serial port, clear the histograms
+ *
+ ********************************************************************************/
+void vProf_Init(void)
+{
+    Serial.begin(PROF_BAUDRATE);
+    vProf_Reset();
+}
+
+/*********************************************************************************
+ * @brief Open a probe
+ *
+ * @return uint32_t start timestamp, to hand back to vProf_Stop
+ ********************************************************************************/
+uint32_t u32Prof_Start(void)
+{
+    if (u8Prof_Depth < PROF_DEPTH)
+    { u8Prof_Depth++; }
+    tu32Prof_Child[u8Prof_Depth] = 0;
+    return micros();
+}
+
+/*********************************************************************************
+ * @brief Close the innermost probe, record its self time and charge the
+ *        total to the enclosing one
+ *
+ * @param FeProbe
+ * @param Fu32Start value returned by u32Prof_Start
+ ********************************************************************************/
+void vProf_Stop(TeProf_Probe FeProbe, uint32_t Fu32Start)
+{
+    uint32_t u32Total = micros() - Fu32Start;
+    uint32_t u32Child = tu32Prof_Child[u8Prof_Depth];
+
+    if (u8Prof_Depth > 0)
+    { u8Prof_Depth--; }
+    tu32Prof_Child[u8Prof_Depth] += u32Total;
+    vProf_Record(FeProbe, (u32Total > u32Child) ? (u32Total - u32Child) : 0);
+}
+
+/*********************************************************************************
+ * @brief Add one sample
+ *
+ * @param FeProbe
+ * @param Fu32Us
+ ********************************************************************************/
+void vProf_Record(TeProf_Probe FeProbe, uint32_t Fu32Us)
+{
+    TstProf_Histogram* pstHisto = &tstProf_Histo[FeProbe];
+    uint8_t u8Bucket = u8Prof_Bucket(Fu32Us);
+
+    if (pstHisto->tu16Buckets[u8Bucket] == 0xFFFF)
+    {   // halve everything, the shape and the percentiles are kept
+        for (uint8_t u8Index = 0; u8Index < PROF_NB_BUCKETS; u8Index++)
+        { pstHisto->tu16Buckets[u8Index] = (pstHisto->tu16Buckets[u8Index] + 1) >> 1; }
+    }
+    pstHisto->tu16Buckets[u8Bucket]++;
+    pstHisto->u32Count++;
+    if (Fu32Us < pstHisto->u32Min)
+    { pstHisto->u32Min = Fu32Us; }
+    if (Fu32Us > pstHisto->u32Max)
+    { pstHisto->u32Max = Fu32Us; }
+}
+
+/*********************************************************************************
+ * @brief Call first thing in loop(): record the loop period, serve the
+ *        serial commands
+ *
+ ********************************************************************************/
+void vProf_Loop(void)
+{
+    uint32_t u32Now = micros();
+
+    if (u8Prof_LoopValid)
+    { vProf_Record(eProf_Period, u32Now - u32Prof_LoopStart); }
+    u32Prof_LoopStart = u32Now;
+    u8Prof_LoopValid = 1;
+
+    while (Serial.available() > 0)
+    {
+        switch (Serial.read())
+        {
+            case 'p':
+            vProf_Dump();
+            break;
+
+            case 'r':
+            vProf_Reset();
+            break;
+
+            default:
+            break;
+        }
+    }
+}
+
+/*********************************************************************************
+ * @brief Drop the current loop period sample (the loop slept)
+ *
+ ********************************************************************************/
+void vProf_SkipPeriod(void)
+{
+    u8Prof_LoopValid = 0;
+}
+
+/*********************************************************************************
+ * @brief Clear every histogram
+ *
+ ********************************************************************************/
+void vProf_Reset(void)
+{
+    memset((void*)tstProf_Histo, 0, sizeof(tstProf_Histo));
+    for (uint8_t u8Probe = 0; u8Probe < eProf_NbProbe; u8Probe++)
+    { tstProf_Histo[u8Probe].u32Min = 0xFFFFFFFF; }
+    memset((void*)tstProf_Latency, 0, sizeof(tstProf_Latency));
+    for (uint8_t u8Tag = 0; u8Tag < PROF_NB_TAGS; u8Tag++)
+    {
+        tstProf_Latency[u8Tag][0].u32Min = 0xFFFFFFFF;
+        tstProf_Latency[u8Tag][1].u32Min = 0xFFFFFFFF;
+    }
+    u8Prof_LoopValid = 0;
+    u8Prof_EdgePending = 0;
+}
+
+/*********************************************************************************
+ * @brief Print a summary line per probe, then the non empty buckets
+ *
+ ********************************************************************************/
+void vProf_Dump(void)
+{
+    Serial.println("probe     count    min    p50    p99    max (us)");
+    for (uint8_t u8Probe = 0; u8Probe < eProf_NbProbe; u8Probe++)
+    {
+        const TstProf_Histogram* pstHisto = &tstProf_Histo[u8Probe];
+
+        Serial.print(tpcProf_Names[u8Probe]);
+        vProf_PrintField(pstHisto->u32Count, 13 - strlen(tpcProf_Names[u8Probe]));
+        vProf_PrintField(pstHisto->u32Count ? pstHisto->u32Min : 0, 7);
+        vProf_PrintField(u32Prof_Percentile(pstHisto, 50), 7);
+        vProf_PrintField(u32Prof_Percentile(pstHisto, 99), 7);
+        vProf_PrintField(pstHisto->u32Max, 7);
+        Serial.println();
+    }
+    for (uint8_t u8Probe = 0; u8Probe < eProf_NbProbe; u8Probe++)
+    {
+        for (uint8_t u8Bucket = 0; u8Bucket < PROF_NB_BUCKETS; u8Bucket++)
+        {
+            if (tstProf_Histo[u8Probe].tu16Buckets[u8Bucket] == 0)
+            { continue; }
+            Serial.print(tpcProf_Names[u8Probe]);
+            vProf_PrintField(u32Prof_BucketLow(u8Bucket), 13 - strlen(tpcProf_Names[u8Probe]));
+            Serial.print("..");
+            Serial.print(u32Prof_BucketLow(u8Bucket + 1) - 1);
+            Serial.print(": ");
+            Serial.print(tstProf_Histo[u8Probe].tu16Buckets[u8Bucket]);
+            Serial.println();
+        }
+    }
+    for (uint8_t u8Tag = 0; u8Tag < PROF_NB_TAGS; u8Tag++)
+    {
+        for (uint8_t u8Edge = 0; u8Edge < 2; u8Edge++)
+        {
+            uint8_t u8Press = !u8Edge;      // press line first
+            const TstProf_Latency* pstLatency = &tstProf_Latency[u8Tag][u8Press];
+            if (pstLatency->u32Count == 0)
+            { continue; }
+            Serial.print(u8Press ? "press   mode " : "release mode ");
+            Serial.print(u8Tag);
+            vProf_PrintField(pstLatency->u32Count, 6);
+            vProf_PrintField(pstLatency->u32Min, 7);
+            vProf_PrintField(pstLatency->u32Sum / pstLatency->u32Count, 7);
+            vProf_PrintField(pstLatency->u32Max, 7);
+            Serial.println(" (count min avg max us)");
+        }
+    }
+}
+
+/*********************************************************************************
+ * @brief Debounced trigger edge, waits for the first frame that shows it
+ *
+ * @param Fu8Level pin level, LOW is a press
+ * @param Fu32EdgeUs micros() of the raw edge
+ ********************************************************************************/
+void vProf_TraceEdge(uint8_t Fu8Level, uint32_t Fu32EdgeUs)
+{
+    u32Prof_EdgeUs = Fu32EdgeUs;
+    u8Prof_EdgePress = !Fu8Level;
+    u8Prof_EdgePending = 1;
+}
+
+/*********************************************************************************
+ * @brief Frame handed to the output, closes the pending edge if it shows it
+ *
+ * @param Fu8Tag stats slot, PROF_TAG_NONE drops the pending edge
+ * @param Fu8Lit at least one pixel on
+ ********************************************************************************/
+void vProf_TraceShow(uint8_t Fu8Tag, uint8_t Fu8Lit)
+{
+    if (!u8Prof_EdgePending)
+    { return; }
+    if (Fu8Tag >= PROF_NB_TAGS)
+    {
+        u8Prof_EdgePending = 0;
+        return;
+    }
+    if (Fu8Lit == u8Prof_EdgePress)
+    {
+        vProf_AddLatency(&tstProf_Latency[Fu8Tag][u8Prof_EdgePress], micros() - u32Prof_EdgeUs);
+        u8Prof_EdgePending = 0;
+    }
+}
+
+/*********************************************************************************
+ * @brief Edge to light statistics
+ *
+ * @param Fu8Tag
+ * @param Fu8Press 1 press, 0 release
+ * @return const TstProf_Latency* NULL if the tag has no slot
+ ********************************************************************************/
+const TstProf_Latency* pstProf_GetLatency(uint8_t Fu8Tag, uint8_t Fu8Press)
+{
+    if (Fu8Tag >= PROF_NB_TAGS)
+    { return NULL; }
+    return &tstProf_Latency[Fu8Tag][Fu8Press ? 1 : 0];
+}
+
+/*********************************************************************************
+* Internal functions
+*********************************************************************************/
+
+/*********************************************************************************
+ * @brief Bucket of a sample: exact below 4us, then 4 buckets per octave
+ *
+ * @param Fu32Us
+ * @return uint8_t
+ ********************************************************************************/
+static uint8_t u8Prof_Bucket(uint32_t Fu32Us)
+{
+    uint8_t u8Msb = PROF_SUB_BITS;
+    uint8_t u8Bucket;
+
+    if (Fu32Us < PROF_SUB)
+    { return (uint8_t)Fu32Us; }
+    while ((Fu32Us >> (u8Msb + 1)) != 0)
+    { u8Msb++; }
+    u8Bucket = ((u8Msb - PROF_SUB_BITS + 1) << PROF_SUB_BITS) + ((Fu32Us >> (u8Msb - PROF_SUB_BITS)) & (PROF_SUB - 1));
+    return (u8Bucket < PROF_NB_BUCKETS) ? u8Bucket : (PROF_NB_BUCKETS - 1);
+}
+
+/*********************************************************************************
+ * @brief Smallest sample that falls into a bucket
+ *
+ * @param Fu8Bucket
+ * @return uint32_t
+ ********************************************************************************/
+static uint32_t u32Prof_BucketLow(uint8_t Fu8Bucket)
+{
+    uint8_t u8Octave = Fu8Bucket >> PROF_SUB_BITS;
+
+    if (u8Octave == 0)
+    { return Fu8Bucket; }
+    return (uint32_t)(PROF_SUB + (Fu8Bucket & (PROF_SUB - 1))) << (u8Octave - 1);
+}
+
+/*********************************************************************************
+ * @brief Upper bound of the bucket holding the given percentile, clamped to
+ *        the recorded range
+ *
+ * @param FpstHisto
+ * @param Fu8Percent
+ * @return uint32_t
+ ********************************************************************************/
+static uint32_t u32Prof_Percentile(const TstProf_Histogram* FpstHisto, uint8_t Fu8Percent)
+{
+    uint32_t u32Total = 0;
+    uint32_t u32Sum = 0;
+    uint32_t u32Target;
+
+    if (FpstHisto->u32Count == 0)
+    { return 0; }
+    for (uint8_t u8Bucket = 0; u8Bucket < PROF_NB_BUCKETS; u8Bucket++)
+    { u32Total += FpstHisto->tu16Buckets[u8Bucket]; }
+    u32Target = (u32Total * Fu8Percent + 99) / 100;
+
+    for (uint8_t u8Bucket = 0; u8Bucket < (PROF_NB_BUCKETS - 1); u8Bucket++)
+    {
+        u32Sum += FpstHisto->tu16Buckets[u8Bucket];
+        if (u32Sum >= u32Target)
+        {
+            uint32_t u32High = u32Prof_BucketLow(u8Bucket + 1) - 1;
+            if (u32High > FpstHisto->u32Max)
+            { u32High = FpstHisto->u32Max; }
+            if (u32High < FpstHisto->u32Min)
+            { u32High = FpstHisto->u32Min; }
+            return u32High;
+        }
+    }
+    return FpstHisto->u32Max;
+}
+
+/*********************************************************************************
+ * @brief Right aligned number, Print has no width specifier
+ *
+ * @param Fu32Value
+ * @param Fu8Width
+ ********************************************************************************/
+static void vProf_PrintField(uint32_t Fu32Value, uint8_t Fu8Width)
+{
+    uint8_t u8Digits = 1;
+
+    for (uint32_t u32Rest = Fu32Value / 10; u32Rest != 0; u32Rest /= 10)
+    { u8Digits++; }
+    while (Fu8Width-- > u8Digits)
+    { Serial.print(' '); }
+    Serial.print(Fu32Value);
+}
+
+static void vProf_AddLatency(TstProf_Latency* FpstLatency, uint32_t Fu32Us)
+{
+    FpstLatency->u32Count++;
+    FpstLatency->u32Sum += Fu32Us;
+    if (Fu32Us < FpstLatency->u32Min)
+    { FpstLatency->u32Min = Fu32Us; }
+    if (Fu32Us > FpstLatency->u32Max)
+    { FpstLatency->u32Max = Fu32Us; }
+}
+#endif
@@ -0,0 +1,74 @@
+/**
+ * @brief Frame timing instrumentation
+ * @file ProfMng.h
+ * @version 0.1
+ * @date 2026-10-17
+ * @author Nello (nello.chom@protonmail.com)
+ */
+
+#ifndef _PROF_MNG_H_
+#define _PROF_MNG_H_
+
+/*********************************************************************************
+* Includes
+*********************************************************************************/
+#include "config.h"
+
+/*********************************************************************************
+* Types & definitions
+*********************************************************************************/
+typedef enum {
+    eProf_Render = 0,   ///< renderer, time spent in show excluded
+    eProf_Show,         ///< vOut_Submit, wait for the previous transfer included
+    eProf_Slot,         ///< PRECISE_TIMING: frame rendered early, wait for its slot
+    eProf_Period,       ///< loop() start to loop() start
+    eProf_Buttons,      ///< vUtils_ButtonManager
+    eProf_NbProbe
+} TeProf_Probe;
+
+// latency stats slots, one per run mode: mirrors TeAnim_RunMode, checked in AnimMng.cpp
+#define PROF_NB_TAGS        (4 + ((DEVICE_MODE != DEVICE_SIMPLE) ? 3 : 0) + IMG_PLAYBACK + NET_STREAM)
+#define PROF_TAG_NONE       0xFF    // frame outside of any traced mode
+
+typedef struct {
+    uint32_t u32Count;
+    uint32_t u32Min;
+    uint32_t u32Max;
+    uint32_t u32Sum;
+} TstProf_Latency;
+
+#if PROFILING
+// self time: nested probes are subtracted from the enclosing one
+#define PROF_START(x)           uint32_t x = u32Prof_Start()
+#define PROF_STOP(probe, x)     vProf_Stop(probe, x)
+#define PROF_LOOP()             vProf_Loop()
+#define PROF_SKIP_PERIOD()      vProf_SkipPeriod()
+#define PROF_TRACE_EDGE(l, t)   vProf_TraceEdge(l, t)
+#define PROF_TRACE_SHOW(g, l)   vProf_TraceShow(g, l)
+#else
+#define PROF_START(x)
+#define PROF_STOP(probe, x)
+#define PROF_LOOP()
+#define PROF_SKIP_PERIOD()
+#define PROF_TRACE_EDGE(l, t)
+#define PROF_TRACE_SHOW(g, l)
+#endif
+
+/*********************************************************************************
+* External functions
+*********************************************************************************/
+#if PROFILING
+void vProf_Init(void);
+uint32_t u32Prof_Start(void);
+void vProf_Stop(TeProf_Probe FeProbe, uint32_t Fu32Start);
+void vProf_Record(TeProf_Probe FeProbe, uint32_t Fu32Us);
+void vProf_Loop(void);
+void vProf_SkipPeriod(void);
+void vProf_Reset(void);
+void vProf_Dump(void);
+void vProf_TraceEdge(uint8_t Fu8Level, uint32_t Fu32EdgeUs);
+void vProf_TraceShow(uint8_t Fu8Tag, uint8_t Fu8Lit);
+const TstProf_Latency* pstProf_GetLatency(uint8_t Fu8Tag, uint8_t Fu8Press);
+#endif
+
+#endif //_PROF_MNG_H_
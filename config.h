@@ -18,7 +18,9 @@
 #define DEVICE_STRIP        2       // led strip configuration
 /***********************************/
 
+#ifndef DEVICE_MODE
 #define DEVICE_MODE         DEVICE_SIMPLE ///< configure led mode
+#endif
 
 // PINOUT CONFIGURATION
 #define PIN_BUTTON          3       // trigger (active LOW)
@@ -27,13 +29,70 @@
 
 // TIMINGS
 #define TIME_DEBOUNCE       30      // debounce ms
+#define TIME_CLICK_MAX      500     // longer presses are not clicks, ms
 #define TIME_DOUBLE_CLICK   400     // double click max time ms
 #define TIME_LONG_PUSH      2000    // long push delay in ms
 #define REFRESH_RATE_HZ     50      // animation rate
+#ifndef IMMEDIATE_RESPONSE
+#define IMMEDIATE_RESPONSE  1       // a trigger edge restarts the animation at once instead of waiting for its next frame
+#endif
+#ifndef PRECISE_TIMING
+#define PRECISE_TIMING      1       // frame slots on a micros() grid instead of millis()
+#endif
+#define TIME_FRAME_SPIN_US  1000    // PRECISE_TIMING: frames are rendered up to this early, show waits for the slot
+
+// POWER
+#ifndef IDLE_SLEEP
+#define IDLE_SLEEP          1       // sleep while the trigger is released and the strip is dark
+#endif
+
+// DEBUG
+#ifndef PROFILING
+#define PROFILING           0       // frame timing histograms on Serial ('p' dump, 'r' clear), ~600 bytes of RAM
+#endif
+
+// IMAGE PLAYBACK (strip builds with a file system)
+#ifndef IMG_PLAYBACK
+#if (DEVICE_MODE != DEVICE_SIMPLE) && (defined(ARDUINO_ARCH_ESP32) || defined(LIGHTPEN_HOST))
+#define IMG_PLAYBACK        1
+#else
+#define IMG_PLAYBACK        0
+#endif
+#endif
+#define IMG_PATH            "/image.lpi"    // LittleFS path of the painted image
+#define IMG_COLUMN_RATE_HZ  100     // columns per second while the trigger is held
+
+// MOTION (image columns follow the sweep instead of the time)
+#ifndef IMU_MOTION
+#define IMU_MOTION          0       // needs IMG_PLAYBACK and a sensor (IMU_MPU6050 or vImu_SetDriver)
+#endif
+#ifndef IMU_MPU6050
+#define IMU_MPU6050         0       // MPU6050 on the default I2C pins
+#endif
+#define IMU_SWEEP_AXIS      2       // gyro axis the pen turns around while sweeping (0 x, 1 y, 2 z)
+#define IMU_SWEEP_RADIUS_MM 600     // pivot (shoulder) to pen distance
+#define IMG_COLUMN_PITCH_UM 5000    // sweep distance between two image columns
+#if IMU_MOTION && !IMG_PLAYBACK
+#error "IMU_MOTION drives the image playback, it needs IMG_PLAYBACK"
+#endif
+
+// STREAMING (frames received over UDP, Art-Net ArtDmx packets)
+#ifndef NET_STREAM
+#if (defined(MY_WIFI_SSID) && defined(MY_WIFI_PWD))
+#define NET_STREAM          1
+#else
+#define NET_STREAM          0
+#endif
+#endif
+#ifndef NET_STREAM_PORT
+#define NET_STREAM_PORT     6454    // Art-Net
+#endif
+#define NET_STREAM_UNIVERSE 0       // universe of the first pixel, 170 pixels per universe
+#define NET_POLL_MS         1       // socket poll period of the Stream mode
 
 #if (DEVICE_MODE == DEVICE_SIMPLE)
 #define NB_PIXELS           DEVICE_SIMPLE // onse single led
-#else
+#elif !defined(NB_PIXELS)
 #define NB_PIXELS           30      // led strip size
 #endif
 
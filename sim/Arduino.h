@@ -0,0 +1,83 @@
+/**
+ * @brief Host side Arduino core shim
+ * @file Arduino.h
+ * @version 0.1
+ * @date 2026-10-17
+ * @author Nello (nello.chom@protonmail.com)
+ */
+
+#ifndef _ARDUINO_H_
+#define _ARDUINO_H_
+
+/*********************************************************************************
+* Includes
+*********************************************************************************/
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/*********************************************************************************
+* Types & definitions
+*********************************************************************************/
+#define LOW             0
+#define HIGH            1
+
+#define INPUT           0
+#define OUTPUT          1
+#define INPUT_PULLUP    2
+
+#define CHANGE          1
+#define FALLING         2
+#define RISING          3
+
+#define SIM_NB_PINS     40      ///< virtual GPIO count
+#define NOT_AN_INTERRUPT    -1
+#define digitalPinToInterrupt(p)    (((p) < SIM_NB_PINS) ? (int)(p) : NOT_AN_INTERRUPT)
+#define digitalPinToPort(p)         ((uint8_t)((p) / 32))       // ESP32 layout: GPIO_IN_REG, GPIO_IN1_REG
+#define digitalPinToBitMask(p)      (1UL << ((p) % 32))
+
+#define PROGMEM                     // flat address space, tables stay in .rodata
+#define pgm_read_byte(addr)         (*(const uint8_t*)(addr))
+#define pgm_read_word(addr)         (*(const uint16_t*)(addr))
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+/**
+ * Serial port: output goes to stdout, input is queued by vSim_SerialInput
+ */
+class HardwareSerial {
+public:
+    void begin(uint32_t Fu32Baud);
+    int available(void);
+    int read(void);
+    size_t print(const char* FpcText);
+    size_t print(char FcChar);
+    size_t print(int FiValue);
+    size_t print(unsigned int FuValue);
+    size_t print(long FlValue);
+    size_t print(unsigned long FulValue);
+    size_t println(void);
+    size_t println(const char* FpcText);
+};
+
+extern HardwareSerial Serial;
+
+/*********************************************************************************
+* External functions
+*********************************************************************************/
+uint32_t millis(void);
+uint32_t micros(void);
+void delay(uint32_t Fu32Ms);
+void delayMicroseconds(uint32_t Fu32Us);
+void yield(void);
+
+void pinMode(uint8_t Fu8Pin, uint8_t Fu8Mode);
+int digitalRead(uint8_t Fu8Pin);
+void digitalWrite(uint8_t Fu8Pin, uint8_t Fu8Level);
+void attachInterrupt(int Fi32Irq, void (*FpvIsr)(void), int Fi32Mode);
+void detachInterrupt(int Fi32Irq);
+volatile uint32_t* portInputRegister(uint8_t Fu8Port);
+
+#endif //_ARDUINO_H_
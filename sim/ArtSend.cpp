@@ -0,0 +1,117 @@
+/**
+ * @brief Host side Art-Net sender, shared by lpsend and the simulator
+ * @file ArtSend.cpp
+ * @version 0.1
+ * @date 2026-10-17
+ * @author Nello (nello.chom@protonmail.com)
+ */
+
+/*********************************************************************************
+* Includes
+*********************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include "ArtSend.h"
+#include "../config.h"
+#include "../NetMng.h"
+
+/*********************************************************************************
+* External functions
+*********************************************************************************/
+
+/*********************************************************************************
+ * @brief UDP socket connected to the receiver
+ *
+ * @param FpcHost name or address
+ * @param Fu16Port
+ * @return int socket, -1 on error
+ ********************************************************************************/
+int iArt_Open(const char* FpcHost, uint16_t Fu16Port)
+{
+    struct addrinfo stHints;
+    struct addrinfo* pstResult = NULL;
+    char tcPort[8];
+    int iSocket = -1;
+
+    memset(&stHints, 0, sizeof(stHints));
+    stHints.ai_family = AF_INET;
+    stHints.ai_socktype = SOCK_DGRAM;
+    snprintf(tcPort, sizeof(tcPort), "%u", Fu16Port);
+    if (getaddrinfo(FpcHost, tcPort, &stHints, &pstResult) != 0)
+    { return -1; }
+    iSocket = socket(pstResult->ai_family, pstResult->ai_socktype, pstResult->ai_protocol);
+    if ((iSocket >= 0) && (connect(iSocket, pstResult->ai_addr, pstResult->ai_addrlen) != 0))
+    {
+        close(iSocket);
+        iSocket = -1;
+    }
+    freeaddrinfo(pstResult);
+    return iSocket;
+}
+
+/*********************************************************************************
+ * @brief Send one frame, a packet per universe
+ *
+ * @param FiSocket
+ * @param Fpu8Rgb
+ * @param Fu16Pixels
+ * @param Fu16Universe universe of pixel 0
+ * @param Fu8Sequence
+ * @return int packets sent, -1 on error
+ ********************************************************************************/
+int iArt_SendFrame(int FiSocket, const uint8_t* Fpu8Rgb, uint16_t Fu16Pixels, uint16_t Fu16Universe, uint8_t Fu8Sequence)
+{
+    uint8_t tu8Packet[NET_ARTNET_HEADER_SIZE + NET_ARTNET_MAX_DATA];
+    int iPackets = 0;
+
+    for (uint32_t u32First = 0; u32First < Fu16Pixels; u32First += NET_UNIVERSE_PIXELS)
+    {
+        uint16_t u16Universe = (uint16_t)(Fu16Universe + iPackets);
+        uint16_t u16Count = (uint16_t)(((Fu16Pixels - u32First) < NET_UNIVERSE_PIXELS) ? (Fu16Pixels - u32First) : NET_UNIVERSE_PIXELS);
+        uint16_t u16Length = (uint16_t)(u16Count * 3);
+
+        if (u16Length & 1)
+        { tu8Packet[NET_ARTNET_HEADER_SIZE + u16Length] = 0; }  // even length
+        u16Length += u16Length & 1;
+        memcpy(tu8Packet, NET_ARTNET_ID, NET_ARTNET_ID_SIZE);
+        tu8Packet[8] = (uint8_t)NET_ARTNET_OP_DMX;
+        tu8Packet[9] = (uint8_t)(NET_ARTNET_OP_DMX >> 8);
+        tu8Packet[10] = 0;
+        tu8Packet[11] = NET_ARTNET_VERSION;
+        tu8Packet[12] = Fu8Sequence;
+        tu8Packet[13] = 0;
+        tu8Packet[14] = (uint8_t)u16Universe;
+        tu8Packet[15] = (uint8_t)((u16Universe >> 8) & 0x7F);
+        tu8Packet[16] = (uint8_t)(u16Length >> 8);
+        tu8Packet[17] = (uint8_t)u16Length;
+        memcpy(&tu8Packet[NET_ARTNET_HEADER_SIZE], &Fpu8Rgb[u32First * 3], u16Count * 3);
+        if (send(FiSocket, tu8Packet, NET_ARTNET_HEADER_SIZE + u16Length, 0) < 0)
+        { return -1; }
+        iPackets++;
+    }
+    return iPackets;
+}
+
+/*********************************************************************************
+ * @brief Sequence number after Fu8Sequence, 1..255
+ *
+ * @param Fu8Sequence
+ * @return uint8_t
+ ********************************************************************************/
+uint8_t u8Art_NextSequence(uint8_t Fu8Sequence)
+{
+    return (Fu8Sequence >= 255) ? 1 : (uint8_t)(Fu8Sequence + 1);
+}
+
+/*********************************************************************************
+ * @brief Close the socket
+ *
+ * @param FiSocket
+ ********************************************************************************/
+void vArt_Close(int FiSocket)
+{
+    close(FiSocket);
+}
@@ -0,0 +1,32 @@
+/**
+ * @brief Host side Art-Net sender, shared by lpsend and the simulator
+ * @file ArtSend.h
+ * @version 0.1
+ * @date 2026-10-17
+ * @author Nello (nello.chom@protonmail.com)
+ *
+ * Packet format and pixel to universe mapping are described in NetMng.h.
+ */
+
+#ifndef _ART_SEND_H_
+#define _ART_SEND_H_
+
+/*********************************************************************************
+* Includes
+*********************************************************************************/
+#include <stdint.h>
+
+/*********************************************************************************
+* External functions
+*********************************************************************************/
+int iArt_Open(const char* FpcHost, uint16_t Fu16Port);
+/**
+ * Fpu8Rgb holds r g b of Fu16Pixels pixels, sent as consecutive universes
+ * from Fu16Universe with the same sequence number. Returns the number of
+ * packets sent, -1 on error.
+ */
+int iArt_SendFrame(int FiSocket, const uint8_t* Fpu8Rgb, uint16_t Fu16Pixels, uint16_t Fu16Universe, uint8_t Fu8Sequence);
+uint8_t u8Art_NextSequence(uint8_t Fu8Sequence);
+void vArt_Close(int FiSocket);
+
+#endif //_ART_SEND_H_
@@ -0,0 +1,411 @@
+/**
+ * @brief Animation kernel throughput benchmark
+ * @file Bench.cpp
+ * @version 0.1
+ * @date 2026-10-17
+ * @author Nello (nello.chom@protonmail.com)
+ *
+ * Times every run and config renderer of the current build. The strip length is
+ * a compile time constant, "make bench" rebuilds this for each NB_PIXELS.
+ * Frame capture is disabled so show() only costs the shim call.
+ *
+ * With IMG_PLAYBACK the same picture is then written raw and palette RLE
+ * encoded: Decode* is the time to draw one column into the frame buffer,
+ * Read* the time to fetch the next one from the host file (ns/frame is per
+ * column).
+ *
+ * Before the timings every format is checked: each column drawn by
+ * vImg_GetColumn must be the source column (through the file palette for
+ * LPI1) cropped or padded to NB_PIXELS. The check pictures have odd and even
+ * literal lengths, runs longer than IMG_RLE_MAX_RUN, more colors than a 4 bit
+ * palette and are taller and shorter than the strip. A mismatch fails the run.
+ *
+ * Usage: lightpen_bench [-m min_ms_per_kernel] [-H]
+ */
+
+/*********************************************************************************
+* Includes
+*********************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <chrono>
+#include "SimCore.h"
+#include "LpiEnc.h"
+#include "../config.h"
+#include "../AnimMngInt.h"
+#include "../ImgMng.h"
+
+/*********************************************************************************
+* Types & definitions
+*********************************************************************************/
+#define BENCH_MIN_MS        50      // minimum time spent per kernel
+#define BENCH_MIN_FRAMES    64
+
+#define BENCH_IMAGE_WIDTH   240
+#define BENCH_IMAGE_COLORS  12
+#define BENCH_CHECK_COLORS  40      // more than a 4 bit palette
+#define BENCH_CHECK_TALLER  150     // check picture rows past the strip
+#define BENCH_CHECK_GUARD   8       // pixels after the strip the decoder must not touch
+
+typedef struct {
+    const char* pcName;
+    pvAnim_Render pvKernel;
+} TstBench_Kernel;
+
+typedef struct {
+    const char* pcDecodeName;
+    const char* pcReadName;
+    uint8_t u8Bits;
+} TstBench_Image;
+
+/*********************************************************************************
+* Global variables
+*********************************************************************************/
+extern void setup(void);
+extern CRGB MainLedStip[];
+
+static const TstBench_Kernel tstBench_Kernels[] = {
+    // tpvAnimations order
+    {"RunSolid", vAnim_RunSolid},
+    {"RunFade", vAnim_RunFade},
+    {"RunBlink", vAnim_RunBlink},
+    {"RunAlternate", vAnim_RunAlternate},
+#if (DEVICE_MODE != DEVICE_SIMPLE)
+    {"RunGradient", vAnim_RunGradient},
+    {"RunBicolor", vAnim_RunBicolor},
+    {"RunEdge", vAnim_RunEdge},
+#endif
+    {"ConfigBlink", vAnim_ConfigBlink},
+    {"ConfigFade", vAnim_ConfigFade},
+    {"ConfigAlternate", vAnim_ConfigAlternate},
+#if (DEVICE_MODE != DEVICE_SIMPLE)
+    {"ConfigGradient", vAnim_ConfigGradient},
+    {"ConfigBicolor", vAnim_ConfigBicolor},
+    {"ConfigEdge", vAnim_ConfigEdge},
+#endif
+};
+
+#if IMG_PLAYBACK
+static const TstBench_Image tstBench_Images[] = {
+    {"DecodeRaw", "ReadRaw", 24},
+    {"DecodePal8", "ReadPal8", 8},
+    {"DecodePal4", "ReadPal4", 4},
+};
+static const uint16_t tu16Bench_CheckHeights[] = {
+    NB_PIXELS + BENCH_CHECK_TALLER,
+    NB_PIXELS,
+    (NB_PIXELS > 1) ? (NB_PIXELS - (NB_PIXELS / 3)) : 1,
+};
+#endif
+
+/*********************************************************************************
+* Internal functions
+*********************************************************************************/
+
+/*********************************************************************************
+ * @brief Time one kernel, called directly with a synthetic frame so the
+ *        scheduler cadence does not matter
+ *
+ * @param FpstKernel
+ * @param Fu32MinMs
+ * @return double ns per frame
+ ********************************************************************************/
+static double dBench_Run(const TstBench_Kernel* FpstKernel, uint32_t Fu32MinMs)
+{
+    uint64_t u64Frames = 0;
+    uint64_t u64Ns = 0;
+    TstAnim_Frame stFrame = {0, 0, 1000};
+
+    for (uint8_t u8Warmup = 0; u8Warmup < 8; u8Warmup++)
+    {
+        FpstKernel->pvKernel(MainLedStip, &stFrame);
+        stFrame.u32Index++;
+        stFrame.u32Elapsed += stFrame.u16DeltaMs;
+    }
+
+    while ((u64Ns < (uint64_t)Fu32MinMs * 1000000) || (u64Frames < BENCH_MIN_FRAMES))
+    {
+        std::chrono::steady_clock::time_point xStart = std::chrono::steady_clock::now();
+        for (uint8_t u8Index = 0; u8Index < 32; u8Index++)
+        {
+            FpstKernel->pvKernel(MainLedStip, &stFrame);
+            stFrame.u32Index++;
+            stFrame.u32Elapsed += stFrame.u16DeltaMs;
+        }
+        std::chrono::steady_clock::time_point xEnd = std::chrono::steady_clock::now();
+        u64Ns += std::chrono::duration_cast<std::chrono::nanoseconds>(xEnd - xStart).count();
+        u64Frames += 32;
+    }
+
+    return (double)u64Ns / u64Frames;
+}
+
+#if IMG_PLAYBACK
+/*********************************************************************************
+ * @brief Light painting like picture: diagonal bands of a few colors, a
+ *        lighter pixel every 7 to break the runs
+ *
+ * @param Fpu8Rgb column major, BENCH_IMAGE_WIDTH * NB_PIXELS
+ ********************************************************************************/
+static void vBench_Picture(uint8_t* Fpu8Rgb)
+{
+    for (uint16_t u16Column = 0; u16Column < BENCH_IMAGE_WIDTH; u16Column++)
+    {
+        for (uint16_t u16Pixel = 0; u16Pixel < NB_PIXELS; u16Pixel++)
+        {
+            uint8_t u8Color = ((u16Pixel / 6) + (u16Column / 12)) % BENCH_IMAGE_COLORS;
+            CRGB rgbPixel = CHSV(u8Color * (256 / BENCH_IMAGE_COLORS), 255, ((u16Pixel % 7) == 0) ? 255 : 160);
+            uint8_t* pu8Px = &Fpu8Rgb[((u16Column * NB_PIXELS) + u16Pixel) * 3];
+            pu8Px[0] = rgbPixel.r;
+            pu8Px[1] = rgbPixel.g;
+            pu8Px[2] = rgbPixel.b;
+        }
+    }
+}
+
+/*********************************************************************************
+ * @brief Decoder check picture: per column, segments of a literal stretch of
+ *        1 to 6 pixels then a run of 3 to 162 pixels, lengths shifting from
+ *        column to column so packets end on both sides of NB_PIXELS
+ *
+ * @param Fpu8Rgb column major, BENCH_IMAGE_WIDTH * Fu16Height
+ * @param Fu16Height
+ ********************************************************************************/
+static void vBench_CheckPicture(uint8_t* Fpu8Rgb, uint16_t Fu16Height)
+{
+    for (uint16_t u16Column = 0; u16Column < BENCH_IMAGE_WIDTH; u16Column++)
+    {
+        uint16_t u16Pixel = 0;
+
+        for (uint16_t u16Segment = 0; u16Pixel < Fu16Height; u16Segment++)
+        {
+            uint16_t u16Literal = 1 + ((u16Column + u16Segment) % 6);
+            uint16_t u16Run = 3 + (((u16Column * 7) + (u16Segment * 31)) % 160);
+
+            for (uint16_t u16Index = 0; (u16Index < (u16Literal + u16Run)) && (u16Pixel < Fu16Height); u16Index++, u16Pixel++)
+            {
+                uint8_t u8Color = (u16Index < u16Literal) ? ((u16Column + (u16Segment * 5) + (u16Index * 3)) % BENCH_CHECK_COLORS)
+                    : ((u16Column + u16Segment) % BENCH_CHECK_COLORS);
+                uint8_t* pu8Px = &Fpu8Rgb[(((uint32_t)u16Column * Fu16Height) + u16Pixel) * 3];
+                pu8Px[0] = (uint8_t)(u8Color * 6);
+                pu8Px[1] = (uint8_t)(255 - (u8Color * 5));
+                pu8Px[2] = (uint8_t)((u8Color * 97) ^ 0x55);
+            }
+        }
+    }
+}
+
+/*********************************************************************************
+ * @brief Play the image under IMG_PATH, every column drawn must be Fpu8Rgb
+ *        mapped to the nearest entry of the file palette (LPI1), cropped or
+ *        padded with black to NB_PIXELS, black past the last column, and
+ *        nothing written after the strip
+ *
+ * @param FpcPath host path of IMG_PATH
+ * @param Fpu8Rgb column major source picture
+ * @param Fu16Height
+ * @param Fu8Bits lLpi_Write format
+ * @return int 0 when every column matches
+ ********************************************************************************/
+static int iBench_CheckImage(const char* FpcPath, const uint8_t* Fpu8Rgb, uint16_t Fu16Height, uint8_t Fu8Bits)
+{
+    static CRGB trgbColumn[NB_PIXELS + BENCH_CHECK_GUARD];
+    uint8_t tu8Palette[IMG_PAL_HEADER_SIZE + (256 * 3)];
+    uint16_t u16Colors = 0;
+    FILE* pFile = fopen(FpcPath, "rb");
+
+    if ((pFile == NULL) || (fread(tu8Palette, 1, sizeof(tu8Palette), pFile) < IMG_HEADER_SIZE))
+    {
+        if (pFile != NULL)
+        { fclose(pFile); }
+        printf("%s: unreadable\n", FpcPath);
+        return 1;
+    }
+    fclose(pFile);
+    if (Fu8Bits != 24)
+    { u16Colors = tu8Palette[9] + 1; }
+
+    if (!u8Img_Init())
+    {
+        printf("%s: %u bit image of height %u not playable\n", FpcPath, Fu8Bits, Fu16Height);
+        return 1;
+    }
+    for (uint16_t u16Column = 0; u16Column <= BENCH_IMAGE_WIDTH; u16Column++)
+    {
+        vImg_Seek(u16Column);
+        vImg_Prefetch();
+        memset((void*)trgbColumn, 0xA5, sizeof(trgbColumn));    // a pixel left out or overrun shows
+        vImg_GetColumn(trgbColumn);
+
+        for (uint16_t u16Pixel = 0; u16Pixel < (NB_PIXELS + BENCH_CHECK_GUARD); u16Pixel++)
+        {
+            uint8_t tu8Expected[3] = {0, 0, 0};
+
+            if (u16Pixel >= NB_PIXELS)
+            { memset(tu8Expected, 0xA5, 3); }
+            else if ((u16Column < BENCH_IMAGE_WIDTH) && (u16Pixel < Fu16Height))
+            {
+                const uint8_t* pu8Px = &Fpu8Rgb[(((uint32_t)u16Column * Fu16Height) + u16Pixel) * 3];
+                uint32_t u32Best = UINT32_MAX;
+
+                memcpy(tu8Expected, pu8Px, 3);
+                for (uint16_t u16Entry = 0; (u16Entry < u16Colors) && (u32Best != 0); u16Entry++)
+                {
+                    const uint8_t* pu8Entry = &tu8Palette[IMG_PAL_HEADER_SIZE + (u16Entry * 3)];
+                    uint32_t u32Dist = 0;
+
+                    for (uint8_t u8Ch = 0; u8Ch < 3; u8Ch++)
+                    { u32Dist += (uint32_t)((pu8Px[u8Ch] - pu8Entry[u8Ch]) * (pu8Px[u8Ch] - pu8Entry[u8Ch])); }
+                    if (u32Dist < u32Best)
+                    {
+                        u32Best = u32Dist;
+                        memcpy(tu8Expected, pu8Entry, 3);
+                    }
+                }
+            }
+            if ((trgbColumn[u16Pixel].r != tu8Expected[0]) || (trgbColumn[u16Pixel].g != tu8Expected[1])
+                || (trgbColumn[u16Pixel].b != tu8Expected[2]))
+            {
+                printf("%u bit image of height %u: column %u pixel %u is %02x%02x%02x, expected %02x%02x%02x\n",
+                       Fu8Bits, Fu16Height, u16Column, u16Pixel, trgbColumn[u16Pixel].r, trgbColumn[u16Pixel].g,
+                       trgbColumn[u16Pixel].b, tu8Expected[0], tu8Expected[1], tu8Expected[2]);
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+/*********************************************************************************
+ * @brief Time column decoding and reading of the image under IMG_PATH
+ *
+ * @param Fu32MinMs
+ * @param FpdDecode ns per column
+ * @param FpdRead ns per column
+ ********************************************************************************/
+static void vBench_RunImage(uint32_t Fu32MinMs, double* FpdDecode, double* FpdRead)
+{
+    uint64_t u64DecodeNs = 0;
+    uint64_t u64ReadNs = 0;
+    uint64_t u64Decodes = 0;
+    uint64_t u64Reads = 0;
+
+    while ((u64DecodeNs < (uint64_t)Fu32MinMs * 1000000) || (u64ReadNs < (uint64_t)Fu32MinMs * 1000000) || (u64Reads < BENCH_MIN_FRAMES))
+    {
+        std::chrono::steady_clock::time_point xStart = std::chrono::steady_clock::now();
+        for (uint8_t u8Index = 0; u8Index < 32; u8Index++)
+        { vImg_GetColumn(MainLedStip); }
+        std::chrono::steady_clock::time_point xEnd = std::chrono::steady_clock::now();
+        u64DecodeNs += std::chrono::duration_cast<std::chrono::nanoseconds>(xEnd - xStart).count();
+        u64Decodes += 32;
+
+        if ((u16Img_GetColumn() + 8) >= u16Img_GetWidth())
+        { vImg_Rewind(); }
+        xStart = std::chrono::steady_clock::now();
+        for (uint8_t u8Index = 0; u8Index < 8; u8Index++)
+        {
+            vImg_Seek(u16Img_GetColumn() + 1);
+            vImg_Prefetch();
+        }
+        xEnd = std::chrono::steady_clock::now();
+        u64ReadNs += std::chrono::duration_cast<std::chrono::nanoseconds>(xEnd - xStart).count();
+        u64Reads += 8;
+    }
+
+    *FpdDecode = (double)u64DecodeNs / u64Decodes;
+    *FpdRead = (double)u64ReadNs / u64Reads;
+}
+#endif
+
+/*********************************************************************************
+* External functions
+*********************************************************************************/
+int main(int argc, char** argv)
+{
+    uint32_t u32MinMs = BENCH_MIN_MS;
+    bool bHeader = false;
+    int iOpt;
+
+    while ((iOpt = getopt(argc, argv, "m:H")) != -1)
+    {
+        switch (iOpt)
+        {
+            case 'm':
+            u32MinMs = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+
+            case 'H':
+            bHeader = true;
+            break;
+
+            default:
+            fprintf(stderr, "usage: %s [-m min_ms_per_kernel] [-H]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    vSim_Init();
+    setup();
+    vSim_SetPin(PIN_BUTTON, LOW);   // trigger held: run kernels draw their lit frame
+    vSim_Run(100);
+    vSim_SetCapture(false);
+
+    if (bHeader)
+    { printf("%-6s %-16s %12s %10s\n", "pixels", "kernel", "ns/frame", "ns/pixel"); }
+
+    for (uint8_t u8Index = 0; u8Index < (sizeof(tstBench_Kernels) / sizeof(tstBench_Kernels[0])); u8Index++)
+    {
+        double dNs = dBench_Run(&tstBench_Kernels[u8Index], u32MinMs);
+        printf("%-6d %-16s %12.1f %10.2f\n", NB_PIXELS, tstBench_Kernels[u8Index].pcName, dNs, dNs / NB_PIXELS);
+    }
+
+#if IMG_PLAYBACK
+    char tcDir[] = "/tmp/lightpen_bench_XXXXXX";
+    char tcPath[64];
+    static uint8_t tu8Picture[BENCH_IMAGE_WIDTH * NB_PIXELS * 3];
+
+    if (mkdtemp(tcDir) == NULL)
+    {
+        perror("mkdtemp");
+        return 1;
+    }
+    snprintf(tcPath, sizeof(tcPath), "%s%s", tcDir, IMG_PATH);
+    vSim_SetFsRoot(tcDir);
+    for (uint8_t u8Height = 0; u8Height < (sizeof(tu16Bench_CheckHeights) / sizeof(tu16Bench_CheckHeights[0])); u8Height++)
+    {
+        static uint8_t tu8Check[BENCH_IMAGE_WIDTH * (NB_PIXELS + BENCH_CHECK_TALLER) * 3];
+
+        vBench_CheckPicture(tu8Check, tu16Bench_CheckHeights[u8Height]);
+        for (uint8_t u8Index = 0; u8Index < (sizeof(tstBench_Images) / sizeof(tstBench_Images[0])); u8Index++)
+        {
+            if ((lLpi_Write(tcPath, tu8Check, BENCH_IMAGE_WIDTH, tu16Bench_CheckHeights[u8Height], tstBench_Images[u8Index].u8Bits) < 0)
+                || iBench_CheckImage(tcPath, tu8Check, tu16Bench_CheckHeights[u8Height], tstBench_Images[u8Index].u8Bits))
+            {
+                unlink(tcPath);
+                rmdir(tcDir);
+                return 1;
+            }
+        }
+    }
+    vBench_Picture(tu8Picture);
+    for (uint8_t u8Index = 0; u8Index < (sizeof(tstBench_Images) / sizeof(tstBench_Images[0])); u8Index++)
+    {
+        double dDecode;
+        double dRead;
+
+        if ((lLpi_Write(tcPath, tu8Picture, BENCH_IMAGE_WIDTH, NB_PIXELS, tstBench_Images[u8Index].u8Bits) < 0)
+            || iBench_CheckImage(tcPath, tu8Picture, NB_PIXELS, tstBench_Images[u8Index].u8Bits) || !u8Img_Init())
+        {
+            fprintf(stderr, "%s: image not playable\n", tcPath);
+            return 1;
+        }
+        vBench_RunImage(u32MinMs, &dDecode, &dRead);
+        printf("%-6d %-16s %12.1f %10.2f\n", NB_PIXELS, tstBench_Images[u8Index].pcDecodeName, dDecode, dDecode / NB_PIXELS);
+        printf("%-6d %-16s %12.1f %10.2f\n", NB_PIXELS, tstBench_Images[u8Index].pcReadName, dRead, dRead / NB_PIXELS);
+    }
+    unlink(tcPath);
+    rmdir(tcDir);
+#endif
+    return 0;
+}
@@ -0,0 +1,306 @@
+/**
+ * @brief Host side FastLED shim
+ * @file FastLED.cpp
+ * @version 0.1
+ * @date 2026-10-17
+ * @author Nello (nello.chom@protonmail.com)
+ */
+
+/*********************************************************************************
+* Includes
+*********************************************************************************/
+#include <FastLED.h>
+#include "SimCore.h"
+
+/*********************************************************************************
+* Global variables
+*********************************************************************************/
+CFastLED FastLED;
+
+/*********************************************************************************
+* External functions
+*********************************************************************************/
+
+/*********************************************************************************
+ * @brief Push data to the simulated wire
+ *
+ * @param data
+ * @param nLeds
+ * @param brightness
+ ********************************************************************************/
+void CLEDController::show(const struct CRGB* data, int nLeds, uint8_t brightness)
+{
+    vSim_OnShow(data, (uint16_t)nLeds, brightness);
+}
+
+/*********************************************************************************
+ * @brief Clear every registered buffer
+ *
+ * @param writeData push the black frame as well
+ ********************************************************************************/
+void CFastLED::clear(bool writeData)
+{
+    for (int i = 0; i < m_nControllers; i++)
+    {
+        m_Controllers[i].clearLedData();
+    }
+    if (writeData)
+    { show(0); }
+}
+
+/*********************************************************************************
+ * @brief Push every registered buffer
+ *
+ * @param scale
+ ********************************************************************************/
+void CFastLED::show(uint8_t scale)
+{
+    for (int i = 0; i < m_nControllers; i++)
+    {
+        m_Controllers[i].showLeds(scale);
+    }
+}
+
+/*********************************************************************************
+ * @brief Integer square root
+ *
+ * @param x
+ * @return uint8_t
+ ********************************************************************************/
+uint8_t sqrt16(uint16_t x)
+{
+    if (x <= 1)
+    { return x; }
+
+    uint8_t low = 1;
+    uint8_t hi = (x > 7904) ? 255 : (x >> 5) + 8;
+    uint8_t mid;
+    do
+    {
+        mid = (low + hi) >> 1;
+        if ((uint16_t)(mid * mid) > x)
+        { hi = mid - 1; }
+        else
+        {
+            if (mid == 255)
+            { return 255; }
+            low = mid + 1;
+        }
+    } while (hi >= low);
+
+    return low - 1;
+}
+
+/*********************************************************************************
+ * @brief Rainbow HSV to RGB conversion (FastLED default for CHSV -> CRGB)
+ *
+ * @param hsv
+ * @param rgb
+ ********************************************************************************/
+void hsv2rgb_rainbow(const CHSV& hsv, CRGB& rgb)
+{
+    uint8_t hue = hsv.hue;
+    uint8_t sat = hsv.sat;
+    uint8_t val = hsv.val;
+
+    uint8_t offset8 = (hue & 0x1F) << 3;
+    uint8_t third = scale8(offset8, (256 / 3));
+    uint8_t twothirds = scale8(offset8, ((256 * 2) / 3));
+    uint8_t r, g, b;
+
+    switch (hue >> 5)
+    {
+        case 0: r = 255 - third; g = third;      b = 0;              break; // R -> O
+        case 1: r = 171;         g = 85 + third; b = 0;              break; // O -> Y
+        case 2: r = 171 - twothirds; g = 170 + third; b = 0;         break; // Y -> G
+        case 3: r = 0;           g = 255 - third; b = third;         break; // G -> A
+        case 4: r = 0;           g = 171 - twothirds; b = 85 + twothirds; break; // A -> B
+        case 5: r = third;       g = 0;          b = 255 - third;    break; // B -> P
+        case 6: r = 85 + third;  g = 0;          b = 171 - third;    break; // P -> K
+        default: r = 170 + third; g = 0;         b = 85 - third;     break; // K -> R
+    }
+
+    if (sat != 255)
+    {
+        if (sat == 0)
+        { r = 255; g = 255; b = 255; }
+        else
+        {
+            uint8_t desat = 255 - sat;
+            desat = scale8_video(desat, desat);
+            uint8_t satscale = 255 - desat;
+            r = scale8(r, satscale) + desat;
+            g = scale8(g, satscale) + desat;
+            b = scale8(b, satscale) + desat;
+        }
+    }
+
+    if (val != 255)
+    {
+        val = scale8_video(val, val);
+        if (val == 0)
+        { r = 0; g = 0; b = 0; }
+        else
+        {
+            r = scale8(r, val);
+            g = scale8(g, val);
+            b = scale8(b, val);
+        }
+    }
+
+    rgb.r = r;
+    rgb.g = g;
+    rgb.b = b;
+}
+
+/*********************************************************************************
+ * @brief Approximate RGB to HSV conversion, FastLED port
+ *
+ * @param rgb
+ * @return CHSV
+ ********************************************************************************/
+CHSV rgb2hsv_approximate(const CRGB& rgb)
+{
+    uint8_t r = rgb.r;
+    uint8_t g = rgb.g;
+    uint8_t b = rgb.b;
+    uint8_t h, s, v;
+
+    uint8_t desat = 255;
+    if (r < desat) desat = r;
+    if (g < desat) desat = g;
+    if (b < desat) desat = b;
+
+    r -= desat;
+    g -= desat;
+    b -= desat;
+
+    s = 255 - desat;
+    if (s != 255)
+    { s = 255 - sqrt16((255 - s) * 256); }
+
+    if ((r + g + b) == 0)
+    { return CHSV(0, 0, 255 - s); }
+
+    if (s < 255)
+    {
+        if (s == 0) s = 1;
+        uint32_t scaleup = 65535 / (s);
+        r = ((uint32_t)(r) * scaleup) / 256;
+        g = ((uint32_t)(g) * scaleup) / 256;
+        b = ((uint32_t)(b) * scaleup) / 256;
+    }
+
+    uint16_t total = r + g + b;
+    if (total < 255)
+    {
+        if (total == 0) total = 1;
+        uint32_t scaleup = 65535 / (total);
+        r = ((uint32_t)(r) * scaleup) / 256;
+        g = ((uint32_t)(g) * scaleup) / 256;
+        b = ((uint32_t)(b) * scaleup) / 256;
+    }
+
+    if (total > 255)
+    { v = 255; }
+    else
+    {
+        v = qadd8(desat, total);
+        if (v != 255) v = sqrt16(v * 256);
+    }
+
+    uint8_t highest = r;
+    if (g > highest) highest = g;
+    if (b > highest) highest = b;
+
+    if (highest == r)
+    {
+        if (g == 0)
+        {
+            h = (HUE_PURPLE + HUE_PINK) / 2;
+            h += scale8(qsub8(r, 128), FIXFRAC8(48, 128));
+        }
+        else if ((r - g) > g)
+        {
+            h = HUE_RED;
+            h += scale8(g, FIXFRAC8(32, 85));
+        }
+        else
+        {
+            h = HUE_ORANGE;
+            h += scale8(qsub8((g - 85) + (171 - r), 4), FIXFRAC8(32, 85));
+        }
+    }
+    else if (highest == g)
+    {
+        if (b == 0)
+        {
+            h = HUE_YELLOW;
+            uint8_t radj = scale8(qsub8(171, r), 47);
+            uint8_t gadj = scale8(qsub8(g, 171), 96);
+            uint8_t rgadj = radj + gadj;
+            h += rgadj / 2;
+        }
+        else if ((g - b) > b)
+        {
+            h = HUE_GREEN;
+            h += scale8(b, FIXFRAC8(32, 85));
+        }
+        else
+        {
+            h = HUE_AQUA;
+            h += scale8(qsub8(b, 85), FIXFRAC8(8, 42));
+        }
+    }
+    else
+    {
+        if (r == 0)
+        {
+            h = HUE_AQUA + ((HUE_BLUE - HUE_AQUA) / 4);
+            h += scale8(qsub8(b, 128), FIXFRAC8(24, 128));
+        }
+        else if ((b - r) > r)
+        {
+            h = HUE_BLUE;
+            h += scale8(r, FIXFRAC8(32, 85));
+        }
+        else
+        {
+            h = HUE_PURPLE;
+            h += scale8(qsub8(r, 85), FIXFRAC8(32, 85));
+        }
+    }
+
+    h += 1;
+    return CHSV(h, s, v);
+}
+
+/*********************************************************************************
+ * @brief Fill a range with a single color
+ *
+ * @param targetArray
+ * @param numToFill
+ * @param color
+ ********************************************************************************/
+void fill_solid(struct CRGB* targetArray, int numToFill, const struct CRGB& color)
+{
+    for (int i = 0; i < numToFill; i++)
+    {
+        targetArray[i] = color;
+    }
+}
+
+/*********************************************************************************
+ * @brief Scale a range by scale/256
+ *
+ * @param leds
+ * @param num_leds
+ * @param scale
+ ********************************************************************************/
+void nscale8(CRGB* leds, uint16_t num_leds, uint8_t scale)
+{
+    for (uint16_t i = 0; i < num_leds; i++)
+    {
+        leds[i].nscale8(scale);
+    }
+}
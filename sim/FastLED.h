@@ -0,0 +1,272 @@
+/**
+ * @brief Host side FastLED shim, subset used by the firmware
+ * @file FastLED.h
+ * @version 0.1
+ * @date 2026-10-17
+ * @author Nello (nello.chom@protonmail.com)
+ *
+ * Color math follows FastLED 3.x (FASTLED_SCALE8_FIXED), output is routed to the
+ * simulator frame log instead of a data pin.
+ */
+
+#ifndef _FASTLED_H_
+#define _FASTLED_H_
+
+/*********************************************************************************
+* Includes
+*********************************************************************************/
+#include <Arduino.h>
+
+/*********************************************************************************
+* Types & definitions
+*********************************************************************************/
+typedef uint16_t accum88;
+typedef int16_t saccum87;
+
+#define FIXFRAC8(N,D)   (((N)*256)/(D))
+
+typedef enum {
+    HUE_RED = 0,
+    HUE_ORANGE = 32,
+    HUE_YELLOW = 64,
+    HUE_GREEN = 96,
+    HUE_AQUA = 128,
+    HUE_BLUE = 160,
+    HUE_PURPLE = 192,
+    HUE_PINK = 224
+} HSVHue;
+
+typedef enum {
+    FORWARD_HUES = 0,
+    BACKWARD_HUES,
+    SHORTEST_HUES,
+    LONGEST_HUES
+} TGradientDirectionCode;
+
+typedef enum {
+    RGB = 0012,
+    GRB = 0102
+} EOrder;
+
+static inline uint8_t scale8(uint8_t i, uint8_t scale)
+{ return (uint8_t)(((uint16_t)i * (1 + (uint16_t)scale)) >> 8); }
+
+static inline uint8_t scale8_video(uint8_t i, uint8_t scale)
+{ return (uint8_t)((((uint16_t)i * scale) >> 8) + ((i && scale) ? 1 : 0)); }
+
+static inline uint8_t qadd8(uint8_t i, uint8_t j)
+{ unsigned int t = i + j; return (t > 255) ? 255 : (uint8_t)t; }
+
+static inline uint8_t qsub8(uint8_t i, uint8_t j)
+{ int t = i - j; return (t < 0) ? 0 : (uint8_t)t; }
+
+uint8_t sqrt16(uint16_t x);
+
+struct CHSV {
+    union {
+        struct {
+            union { uint8_t hue; uint8_t h; };
+            union { uint8_t saturation; uint8_t sat; uint8_t s; };
+            union { uint8_t value; uint8_t val; uint8_t v; };
+        };
+        uint8_t raw[3];
+    };
+
+    inline CHSV() : h(0), s(0), v(0) {}
+    inline CHSV(uint8_t ih, uint8_t is, uint8_t iv) : h(ih), s(is), v(iv) {}
+};
+
+struct CRGB;
+void hsv2rgb_rainbow(const CHSV& hsv, CRGB& rgb);
+CHSV rgb2hsv_approximate(const CRGB& rgb);
+
+struct CRGB {
+    union {
+        struct {
+            union { uint8_t r; uint8_t red; };
+            union { uint8_t g; uint8_t green; };
+            union { uint8_t b; uint8_t blue; };
+        };
+        uint8_t raw[3];
+    };
+
+    typedef enum {
+        Black = 0x000000,
+        Blue = 0x0000FF,
+        Green = 0x008000,
+        Red = 0xFF0000,
+        White = 0xFFFFFF
+    } HTMLColorCode;
+
+    inline CRGB() : r(0), g(0), b(0) {}
+    inline CRGB(uint8_t ir, uint8_t ig, uint8_t ib) : r(ir), g(ig), b(ib) {}
+    inline CRGB(uint32_t colorcode) : r((colorcode >> 16) & 0xFF), g((colorcode >> 8) & 0xFF), b(colorcode & 0xFF) {}
+    inline CRGB(HTMLColorCode colorcode) : r((colorcode >> 16) & 0xFF), g((colorcode >> 8) & 0xFF), b(colorcode & 0xFF) {}
+    inline CRGB(const CHSV& rhs) { hsv2rgb_rainbow(rhs, *this); }
+
+    inline CRGB& operator= (const CHSV& rhs) { hsv2rgb_rainbow(rhs, *this); return *this; }
+    inline CRGB& operator= (uint32_t colorcode)
+    {
+        r = (colorcode >> 16) & 0xFF;
+        g = (colorcode >> 8) & 0xFF;
+        b = colorcode & 0xFF;
+        return *this;
+    }
+
+    inline CRGB& nscale8(uint8_t scaledown)
+    {
+        r = scale8(r, scaledown);
+        g = scale8(g, scaledown);
+        b = scale8(b, scaledown);
+        return *this;
+    }
+
+    inline uint8_t& operator[] (uint8_t x) { return raw[x]; }
+    inline const uint8_t& operator[] (uint8_t x) const { return raw[x]; }
+};
+
+inline bool operator== (const CRGB& lhs, const CRGB& rhs)
+{ return (lhs.r == rhs.r) && (lhs.g == rhs.g) && (lhs.b == rhs.b); }
+
+inline bool operator!= (const CRGB& lhs, const CRGB& rhs)
+{ return !(lhs == rhs); }
+
+typedef enum {
+    TypicalLEDStrip = 0xFFB0F0,
+    UncorrectedColor = 0xFFFFFF
+} LEDColorCorrection;
+
+template <uint8_t DATA_PIN, EOrder RGB_ORDER> class WS2812 {};
+
+/*********************************************************************************
+ * @brief Single output channel, data is pushed to the simulator frame log
+ ********************************************************************************/
+class CLEDController {
+public:
+    CLEDController() : m_Data(NULL), m_nLeds(0), m_Correction(UncorrectedColor) {}
+
+    void init(CRGB* FpData, int FnLeds) { m_Data = FpData; m_nLeds = FnLeds; }
+    CLEDController& setCorrection(LEDColorCorrection correction) { m_Correction = CRGB((uint32_t)correction); return *this; }
+    CLEDController& setCorrection(CRGB correction) { m_Correction = correction; return *this; }
+
+    void show(const struct CRGB* data, int nLeds, uint8_t brightness);
+    void showLeds(uint8_t brightness) { show(m_Data, m_nLeds, brightness); }
+    void clearLedData(void) { if (m_Data) { memset((void*)m_Data, 0, sizeof(CRGB) * m_nLeds); } }
+
+    CRGB* leds(void) { return m_Data; }
+    int size(void) { return m_nLeds; }
+
+private:
+    CRGB* m_Data;
+    int m_nLeds;
+    CRGB m_Correction;
+};
+
+/*********************************************************************************
+ * @brief FastLED global object
+ ********************************************************************************/
+class CFastLED {
+public:
+    CFastLED() : m_nControllers(0), m_Brightness(255) {}
+
+    template<template<uint8_t DATA_PIN, EOrder RGB_ORDER> class CHIPSET, uint8_t DATA_PIN, EOrder RGB_ORDER>
+    CLEDController& addLeds(struct CRGB* data, int nLeds)
+    {
+        CLEDController& rCtrl = m_Controllers[m_nControllers < FASTLED_SIM_CONTROLLERS ? m_nControllers++ : (FASTLED_SIM_CONTROLLERS - 1)];
+        rCtrl.init(data, nLeds);
+        return rCtrl;
+    }
+
+    void setBrightness(uint8_t scale) { m_Brightness = scale; }
+    uint8_t getBrightness(void) { return m_Brightness; }
+
+    void clear(bool writeData = false);
+    void show(void) { show(m_Brightness); }
+    void show(uint8_t scale);
+
+    int count(void) { return m_nControllers; }
+    CLEDController& operator[] (int x) { return m_Controllers[x]; }
+
+private:
+    enum { FASTLED_SIM_CONTROLLERS = 4 };
+    CLEDController m_Controllers[FASTLED_SIM_CONTROLLERS];
+    int m_nControllers;
+    uint8_t m_Brightness;
+};
+
+extern CFastLED FastLED;
+
+/*********************************************************************************
+* External functions
+*********************************************************************************/
+void fill_solid(struct CRGB* targetArray, int numToFill, const struct CRGB& color);
+void nscale8(CRGB* leds, uint16_t num_leds, uint8_t scale);
+
+/*********************************************************************************
+ * @brief HSV gradient between two positions, FastLED colorutils port
+ ********************************************************************************/
+template <typename T>
+void fill_gradient(T* targetArray, uint16_t startpos, CHSV startcolor, uint16_t endpos, CHSV endcolor,
+                   TGradientDirectionCode directionCode = SHORTEST_HUES)
+{
+    if (endpos < startpos)
+    {
+        uint16_t t = endpos;
+        CHSV tc = endcolor;
+        endcolor = startcolor;
+        endpos = startpos;
+        startpos = t;
+        startcolor = tc;
+    }
+
+    if (endcolor.value == 0 || endcolor.saturation == 0)
+    { endcolor.hue = startcolor.hue; }
+    if (startcolor.value == 0 || startcolor.saturation == 0)
+    { startcolor.hue = endcolor.hue; }
+
+    saccum87 huedistance87;
+    saccum87 satdistance87 = (endcolor.sat - startcolor.sat) << 7;
+    saccum87 valdistance87 = (endcolor.val - startcolor.val) << 7;
+    uint8_t huedelta8 = endcolor.hue - startcolor.hue;
+
+    if (directionCode == SHORTEST_HUES)
+    { directionCode = (huedelta8 > 127) ? BACKWARD_HUES : FORWARD_HUES; }
+    if (directionCode == LONGEST_HUES)
+    { directionCode = (huedelta8 < 128) ? BACKWARD_HUES : FORWARD_HUES; }
+
+    if (directionCode == FORWARD_HUES)
+    { huedistance87 = huedelta8 << 7; }
+    else
+    {
+        huedistance87 = (uint8_t)(256 - huedelta8) << 7;
+        huedistance87 = -huedistance87;
+    }
+
+    uint16_t pixeldistance = endpos - startpos;
+    int16_t divisor = pixeldistance ? pixeldistance : 1;
+
+    saccum87 huedelta87 = (huedistance87 / divisor) * 2;
+    saccum87 satdelta87 = (satdistance87 / divisor) * 2;
+    saccum87 valdelta87 = (valdistance87 / divisor) * 2;
+
+    accum88 hue88 = startcolor.hue << 8;
+    accum88 sat88 = startcolor.sat << 8;
+    accum88 val88 = startcolor.val << 8;
+    for (uint16_t i = startpos; i <= endpos; ++i)
+    {
+        targetArray[i] = CHSV(hue88 >> 8, sat88 >> 8, val88 >> 8);
+        hue88 += huedelta87;
+        sat88 += satdelta87;
+        val88 += valdelta87;
+    }
+}
+
+template <typename T>
+void fill_gradient(T* targetArray, uint16_t numLeds, const CHSV& c1, const CHSV& c2,
+                   TGradientDirectionCode directionCode = SHORTEST_HUES)
+{
+    uint16_t last = numLeds - 1;
+    fill_gradient(targetArray, 0, c1, last, c2, directionCode);
+}
+
+#endif //_FASTLED_H_
@@ -0,0 +1,13 @@
+/**
+ * @brief Sketch translation unit for the host build
+ * @file LightPen.cpp
+ * @version 0.1
+ * @date 2026-10-17
+ * @author Nello (nello.chom@protonmail.com)
+ *
+ * The Arduino builder prepends Arduino.h to .ino files, do the same here so
+ * Light_Pen.ino is compiled unmodified.
+ */
+
+#include <Arduino.h>
+#include "../Light_Pen.ino"
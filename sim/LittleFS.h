@@ -0,0 +1,47 @@
+/**
+ * @brief Host side LittleFS shim, files live under a host directory
+ * @file LittleFS.h
+ * @version 0.1
+ * @date 2026-10-17
+ * @author Nello (nello.chom@protonmail.com)
+ *
+ * Read only subset of the ESP32 FS API. Unlike the target, File does not
+ * close itself when the last copy goes away: call close().
+ */
+
+#ifndef _LITTLEFS_H_
+#define _LITTLEFS_H_
+
+/*********************************************************************************
+* Includes
+*********************************************************************************/
+#include <stdio.h>
+#include <Arduino.h>
+
+/*********************************************************************************
+* Types & definitions
+*********************************************************************************/
+class File {
+public:
+    File(FILE* FpFile = NULL) : pFile(FpFile) {}
+    operator bool() const { return pFile != NULL; }
+    size_t read(uint8_t* FpBuffer, size_t FSize);
+    bool seek(uint32_t Fu32Pos);
+    size_t position(void);
+    size_t size(void);
+    void close(void);
+
+private:
+    FILE* pFile;
+};
+
+class LittleFSFS {
+public:
+    bool begin(bool FbFormatOnFail = false);
+    File open(const char* FpcPath, const char* FpcMode = "r");
+    bool exists(const char* FpcPath);
+};
+
+extern LittleFSFS LittleFS;
+
+#endif //_LITTLEFS_H_
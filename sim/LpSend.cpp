@@ -0,0 +1,118 @@
+/**
+ * @brief Stream a test pattern to a Light Pen in Stream mode
+ * @file LpSend.cpp
+ * @version 0.1
+ * @date 2026-10-17
+ * @author Nello (nello.chom@protonmail.com)
+ *
+ * Usage: lpsend [-p port] [-n pixels] [-r fps] [-c frames] [-u universe] host
+ *
+ * Frames are sent in real time at -r frames per second (default 50), -c stops
+ * after that many frames (default: forever). Pixel p of frame k is
+ * (k, p, k ^ p), the pattern the simulator checks. The simulator streams to
+ * itself, this is for a pen on the network.
+ */
+
+/*********************************************************************************
+* Includes
+*********************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+#include "ArtSend.h"
+#include "../config.h"
+
+/*********************************************************************************
+* Types & definitions
+*********************************************************************************/
+#define SEND_DEFAULT_FPS        50
+
+/*********************************************************************************
+* External functions
+*********************************************************************************/
+int main(int argc, char** argv)
+{
+    std::vector<uint8_t> vFrame;
+    long lPort = NET_STREAM_PORT;
+    long lPixels = NB_PIXELS;
+    long lFps = SEND_DEFAULT_FPS;
+    long lFrames = -1;
+    long lUniverse = NET_STREAM_UNIVERSE;
+    uint8_t u8Sequence = 0;
+    struct timespec stNext;
+    int iSocket;
+    int iOpt;
+
+    while ((iOpt = getopt(argc, argv, "p:n:r:c:u:")) != -1)
+    {
+        switch (iOpt)
+        {
+            case 'p':
+            lPort = strtol(optarg, NULL, 0);
+            break;
+
+            case 'n':
+            lPixels = strtol(optarg, NULL, 0);
+            break;
+
+            case 'r':
+            lFps = strtol(optarg, NULL, 0);
+            break;
+
+            case 'c':
+            lFrames = strtol(optarg, NULL, 0);
+            break;
+
+            case 'u':
+            lUniverse = strtol(optarg, NULL, 0);
+            break;
+
+            default:
+            optind = argc;
+            break;
+        }
+    }
+    if (((argc - optind) != 1) || (lPort <= 0) || (lPort > 0xFFFF) || (lPixels <= 0) || (lPixels > 0xFFFF)
+        || (lFps <= 0) || (lFps > 1000000) || (lUniverse < 0) || (lUniverse > 0x7FFF))
+    {
+        fprintf(stderr, "usage: %s [-p port] [-n pixels] [-r fps] [-c frames] [-u universe] host\n", argv[0]);
+        return 1;
+    }
+    iSocket = iArt_Open(argv[optind], (uint16_t)lPort);
+    if (iSocket < 0)
+    {
+        fprintf(stderr, "%s: cannot reach port %ld\n", argv[optind], lPort);
+        return 1;
+    }
+
+    vFrame.resize((size_t)lPixels * 3);
+    clock_gettime(CLOCK_MONOTONIC, &stNext);
+    for (long lFrame = 0; (lFrames < 0) || (lFrame < lFrames); lFrame++)
+    {
+        for (long lPixel = 0; lPixel < lPixels; lPixel++)
+        {
+            vFrame[lPixel * 3] = (uint8_t)lFrame;
+            vFrame[(lPixel * 3) + 1] = (uint8_t)lPixel;
+            vFrame[(lPixel * 3) + 2] = (uint8_t)(lFrame ^ lPixel);
+        }
+        u8Sequence = u8Art_NextSequence(u8Sequence);
+        if (iArt_SendFrame(iSocket, vFrame.data(), (uint16_t)lPixels, (uint16_t)lUniverse, u8Sequence) < 0)
+        {
+            perror("send");
+            vArt_Close(iSocket);
+            return 1;
+        }
+
+        stNext.tv_nsec += 1000000000L / lFps;
+        while (stNext.tv_nsec >= 1000000000L)
+        {
+            stNext.tv_nsec -= 1000000000L;
+            stNext.tv_sec++;
+        }
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &stNext, NULL);
+    }
+    vArt_Close(iSocket);
+    return 0;
+}
@@ -0,0 +1,175 @@
+/**
+ * @brief Convert a binary PPM (P6) picture into a .lpi light painting image
+ * @file LpiConv.cpp
+ * @version 0.1
+ * @date 2026-10-17
+ * @author Nello (nello.chom@protonmail.com)
+ *
+ * Usage: lpiconv [-n pixels] [-b 24|8|4] [-f] in.ppm out.lpi
+ *
+ * Picture columns are played left to right, the top row lights pixel 0 of the
+ * strip (-f: the bottom row). -n resizes the height to the strip length
+ * (nearest pixel), the width is kept. -b picks raw 24 bit columns (LPI0) or
+ * palette indexed RLE columns (LPI1, default 8 bit indices). Convert with
+ * ImageMagick first for other picture formats.
+ */
+
+/*********************************************************************************
+* Includes
+*********************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <vector>
+#include "LpiEnc.h"
+
+/*********************************************************************************
+* Internal functions
+*********************************************************************************/
+
+/*********************************************************************************
+ * @brief Next header number of a PPM file, comments skipped
+ *
+ * @param FpFile
+ * @return long -1 on error
+ ********************************************************************************/
+static long lConv_ReadNumber(FILE* FpFile)
+{
+    int iChar = fgetc(FpFile);
+    long lValue = 0;
+
+    while ((iChar == '#') || (iChar == ' ') || (iChar == '\t') || (iChar == '\r') || (iChar == '\n'))
+    {
+        if (iChar == '#')
+        {
+            while ((iChar != '\n') && (iChar != EOF))
+            { iChar = fgetc(FpFile); }
+        }
+        iChar = fgetc(FpFile);
+    }
+    if ((iChar < '0') || (iChar > '9'))
+    { return -1; }
+    while ((iChar >= '0') && (iChar <= '9'))
+    {
+        lValue = (lValue * 10) + (iChar - '0');
+        iChar = fgetc(FpFile);
+    }
+    return lValue;      // the single white space after maxval is consumed here
+}
+
+/*********************************************************************************
+ * @brief Load a P6 picture, 8 bit samples
+ *
+ * @param FpcPath
+ * @param FvRgb receives row major r g b
+ * @param FplWidth
+ * @param FplHeight
+ * @return int 0 on success
+ ********************************************************************************/
+static int iConv_ReadPpm(const char* FpcPath, std::vector<uint8_t>& FvRgb, long* FplWidth, long* FplHeight)
+{
+    FILE* pFile = fopen(FpcPath, "rb");
+    long lMax;
+
+    if (pFile == NULL)
+    {
+        perror(FpcPath);
+        return -1;
+    }
+    if ((fgetc(pFile) != 'P') || (fgetc(pFile) != '6'))
+    {
+        fprintf(stderr, "%s: not a binary PPM (P6)\n", FpcPath);
+        fclose(pFile);
+        return -1;
+    }
+    *FplWidth = lConv_ReadNumber(pFile);
+    *FplHeight = lConv_ReadNumber(pFile);
+    lMax = lConv_ReadNumber(pFile);
+    if ((*FplWidth <= 0) || (*FplWidth >= 0xFFFF) || (*FplHeight <= 0) || (*FplHeight > 0xFFFF) || (lMax != 255))
+    {
+        fprintf(stderr, "%s: unsupported size or maxval\n", FpcPath);
+        fclose(pFile);
+        return -1;
+    }
+
+    FvRgb.resize((size_t)*FplWidth * *FplHeight * 3);
+    if (fread(FvRgb.data(), 1, FvRgb.size(), pFile) != FvRgb.size())
+    {
+        fprintf(stderr, "%s: truncated\n", FpcPath);
+        fclose(pFile);
+        return -1;
+    }
+    fclose(pFile);
+    return 0;
+}
+
+/*********************************************************************************
+* External functions
+*********************************************************************************/
+int main(int argc, char** argv)
+{
+    std::vector<uint8_t> vPicture;
+    std::vector<uint8_t> vColumns;
+    long lWidth;
+    long lHeight;
+    long lPixels = 0;
+    long lSize;
+    uint8_t u8Bits = 8;
+    bool bFlip = false;
+    int iOpt;
+
+    while ((iOpt = getopt(argc, argv, "n:b:f")) != -1)
+    {
+        switch (iOpt)
+        {
+            case 'n':
+            lPixels = strtol(optarg, NULL, 0);
+            break;
+
+            case 'b':
+            u8Bits = (uint8_t)strtoul(optarg, NULL, 0);
+            break;
+
+            case 'f':
+            bFlip = true;
+            break;
+
+            default:
+            optind = argc;
+            break;
+        }
+    }
+    if (((argc - optind) != 2) || (lPixels < 0) || (lPixels > 0xFFFF) || ((u8Bits != 24) && (u8Bits != 8) && (u8Bits != 4)))
+    {
+        fprintf(stderr, "usage: %s [-n pixels] [-b 24|8|4] [-f] in.ppm out.lpi\n", argv[0]);
+        return 1;
+    }
+    if (iConv_ReadPpm(argv[optind], vPicture, &lWidth, &lHeight) != 0)
+    { return 1; }
+    if (lPixels == 0)
+    { lPixels = lHeight; }
+
+    // transpose to column major, resample rows to strip pixels
+    vColumns.resize((size_t)lWidth * lPixels * 3);
+    for (long lColumn = 0; lColumn < lWidth; lColumn++)
+    {
+        for (long lPixel = 0; lPixel < lPixels; lPixel++)
+        {
+            long lRow = ((lPixel * 2 + 1) * lHeight) / (lPixels * 2);
+            if (bFlip)
+            { lRow = lHeight - 1 - lRow; }
+            for (uint8_t u8Ch = 0; u8Ch < 3; u8Ch++)
+            { vColumns[(((size_t)lColumn * lPixels) + lPixel) * 3 + u8Ch] = vPicture[(((size_t)lRow * lWidth) + lColumn) * 3 + u8Ch]; }
+        }
+    }
+
+    lSize = lLpi_Write(argv[optind + 1], vColumns.data(), (uint16_t)lWidth, (uint16_t)lPixels, u8Bits);
+    if (lSize < 0)
+    {
+        perror(argv[optind + 1]);
+        return 1;
+    }
+    printf("%s: %ld x %ld, %d bit, %ld bytes (%.1f bytes/column, raw %ld)\n", argv[optind + 1], lWidth, lPixels, u8Bits,
+           lSize, (double)lSize / lWidth, lPixels * 3);
+    return 0;
+}
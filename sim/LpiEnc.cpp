@@ -0,0 +1,332 @@
+/**
+ * @brief Host side .lpi image writer, shared by lpiconv and the benchmark
+ * @file LpiEnc.cpp
+ * @version 0.1
+ * @date 2026-10-17
+ * @author Nello (nello.chom@protonmail.com)
+ *
+ * Palette images with more colors than the index allows are reduced by median
+ * cut on the distinct colors, weighted by their pixel count, then every pixel
+ * takes the nearest palette entry. Columns are RLE packed with runs of at
+ * least LPI_MIN_RUN, shorter repeats stay in the literals.
+ */
+
+/*********************************************************************************
+* Includes
+*********************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+#include <FastLED.h>
+#include "LpiEnc.h"
+#include "../config.h"
+#include "../ImgMng.h"
+
+/*********************************************************************************
+* Types & definitions
+*********************************************************************************/
+#define LPI_MIN_RUN     3
+
+typedef struct {
+    uint8_t tu8Rgb[3];
+    uint32_t u32Count;      // pixels of this color
+} TstLpi_Color;
+
+typedef struct {
+    size_t uStart;          // colors [uStart, uEnd) of tstLpi_Colors
+    size_t uEnd;
+} TstLpi_Box;
+
+/*********************************************************************************
+* Internal functions
+*********************************************************************************/
+
+/*********************************************************************************
+ * @brief Widest channel of a box
+ *
+ * @param FpstColors
+ * @param FstBox
+ * @param Fpu8Range receives the channel span
+ * @return uint8_t channel 0..2
+ ********************************************************************************/
+static uint8_t u8Lpi_WidestChannel(const TstLpi_Color* FpstColors, TstLpi_Box FstBox, uint8_t* Fpu8Range)
+{
+    uint8_t tu8Min[3] = {255, 255, 255};
+    uint8_t tu8Max[3] = {0, 0, 0};
+    uint8_t u8Channel = 0;
+
+    for (size_t uIndex = FstBox.uStart; uIndex < FstBox.uEnd; uIndex++)
+    {
+        for (uint8_t u8Ch = 0; u8Ch < 3; u8Ch++)
+        {
+            tu8Min[u8Ch] = std::min(tu8Min[u8Ch], FpstColors[uIndex].tu8Rgb[u8Ch]);
+            tu8Max[u8Ch] = std::max(tu8Max[u8Ch], FpstColors[uIndex].tu8Rgb[u8Ch]);
+        }
+    }
+    for (uint8_t u8Ch = 1; u8Ch < 3; u8Ch++)
+    {
+        if ((tu8Max[u8Ch] - tu8Min[u8Ch]) > (tu8Max[u8Channel] - tu8Min[u8Channel]))
+        { u8Channel = u8Ch; }
+    }
+    *Fpu8Range = tu8Max[u8Channel] - tu8Min[u8Channel];
+    return u8Channel;
+}
+
+/*********************************************************************************
+ * @brief Reduce the distinct colors to at most Fu16Max palette entries
+ *
+ * @param FvColors sorted in place
+ * @param Fu16Max
+ * @param FvPalette receives r g b triplets
+ ********************************************************************************/
+static void vLpi_MedianCut(std::vector<TstLpi_Color>& FvColors, uint16_t Fu16Max, std::vector<uint8_t>& FvPalette)
+{
+    std::vector<TstLpi_Box> vBoxes(1, TstLpi_Box{0, FvColors.size()});
+
+    while (vBoxes.size() < Fu16Max)
+    {
+        size_t uBest = vBoxes.size();
+        uint8_t u8BestRange = 0;
+        uint8_t u8BestChannel = 0;
+
+        for (size_t uBox = 0; uBox < vBoxes.size(); uBox++)
+        {
+            uint8_t u8Range;
+            uint8_t u8Channel;
+
+            if ((vBoxes[uBox].uEnd - vBoxes[uBox].uStart) < 2)
+            { continue; }
+            u8Channel = u8Lpi_WidestChannel(FvColors.data(), vBoxes[uBox], &u8Range);
+            if ((uBest == vBoxes.size()) || (u8Range > u8BestRange))
+            {
+                uBest = uBox;
+                u8BestRange = u8Range;
+                u8BestChannel = u8Channel;
+            }
+        }
+        if (uBest == vBoxes.size())
+        { break; }     // every box is a single color
+
+        TstLpi_Box stBox = vBoxes[uBest];
+        uint64_t u64Total = 0;
+        uint64_t u64Half = 0;
+        size_t uSplit = stBox.uStart + 1;
+
+        std::sort(FvColors.begin() + stBox.uStart, FvColors.begin() + stBox.uEnd,
+                  [u8BestChannel](const TstLpi_Color& FstA, const TstLpi_Color& FstB)
+                  { return FstA.tu8Rgb[u8BestChannel] < FstB.tu8Rgb[u8BestChannel]; });
+        for (size_t uIndex = stBox.uStart; uIndex < stBox.uEnd; uIndex++)
+        { u64Total += FvColors[uIndex].u32Count; }
+        for (size_t uIndex = stBox.uStart; uIndex < (stBox.uEnd - 1); uIndex++)
+        {
+            u64Half += FvColors[uIndex].u32Count;
+            uSplit = uIndex + 1;
+            if ((u64Half * 2) >= u64Total)
+            { break; }
+        }
+        vBoxes[uBest].uEnd = uSplit;
+        vBoxes.push_back(TstLpi_Box{uSplit, stBox.uEnd});
+    }
+
+    FvPalette.clear();
+    for (size_t uBox = 0; uBox < vBoxes.size(); uBox++)
+    {
+        uint64_t tu64Sum[3] = {0, 0, 0};
+        uint64_t u64Count = 0;
+
+        for (size_t uIndex = vBoxes[uBox].uStart; uIndex < vBoxes[uBox].uEnd; uIndex++)
+        {
+            for (uint8_t u8Ch = 0; u8Ch < 3; u8Ch++)
+            { tu64Sum[u8Ch] += (uint64_t)FvColors[uIndex].tu8Rgb[u8Ch] * FvColors[uIndex].u32Count; }
+            u64Count += FvColors[uIndex].u32Count;
+        }
+        for (uint8_t u8Ch = 0; u8Ch < 3; u8Ch++)
+        { FvPalette.push_back((uint8_t)((tu64Sum[u8Ch] + (u64Count / 2)) / u64Count)); }
+    }
+}
+
+/*********************************************************************************
+ * @brief Palette index of every pixel
+ *
+ * @param Fpu8Rgb
+ * @param FuPixels
+ * @param Fu16Max palette size limit
+ * @param FvPalette receives the palette
+ * @param FvIndices receives one index per pixel
+ ********************************************************************************/
+static void vLpi_Quantize(const uint8_t* Fpu8Rgb, size_t FuPixels, uint16_t Fu16Max,
+                          std::vector<uint8_t>& FvPalette, std::vector<uint8_t>& FvIndices)
+{
+    std::unordered_map<uint32_t, uint32_t> xCounts;
+    std::unordered_map<uint32_t, uint8_t> xMap;
+    std::vector<TstLpi_Color> vColors;
+
+    for (size_t uPixel = 0; uPixel < FuPixels; uPixel++)
+    {
+        const uint8_t* pu8Px = &Fpu8Rgb[uPixel * 3];
+        xCounts[((uint32_t)pu8Px[0] << 16) | (pu8Px[1] << 8) | pu8Px[2]]++;
+    }
+    for (const std::pair<const uint32_t, uint32_t>& xEntry : xCounts)
+    { vColors.push_back(TstLpi_Color{{(uint8_t)(xEntry.first >> 16), (uint8_t)(xEntry.first >> 8), (uint8_t)xEntry.first}, xEntry.second}); }
+    std::sort(vColors.begin(), vColors.end(), [](const TstLpi_Color& FstA, const TstLpi_Color& FstB)
+              { return memcmp(FstA.tu8Rgb, FstB.tu8Rgb, 3) < 0; });    // deterministic output
+    vLpi_MedianCut(vColors, Fu16Max, FvPalette);
+
+    for (const std::pair<const uint32_t, uint32_t>& xEntry : xCounts)
+    {
+        int32_t tiRgb[3] = {(int32_t)(xEntry.first >> 16), (int32_t)((xEntry.first >> 8) & 0xFF), (int32_t)(xEntry.first & 0xFF)};
+        uint32_t u32Best = UINT32_MAX;
+        uint8_t u8Best = 0;
+
+        for (size_t uEntry = 0; uEntry < (FvPalette.size() / 3); uEntry++)
+        {
+            uint32_t u32Dist = 0;
+            for (uint8_t u8Ch = 0; u8Ch < 3; u8Ch++)
+            {
+                int32_t iDiff = tiRgb[u8Ch] - FvPalette[(uEntry * 3) + u8Ch];
+                u32Dist += (uint32_t)(iDiff * iDiff);
+            }
+            if (u32Dist < u32Best)
+            {
+                u32Best = u32Dist;
+                u8Best = (uint8_t)uEntry;
+            }
+        }
+        xMap[xEntry.first] = u8Best;
+    }
+
+    FvIndices.resize(FuPixels);
+    for (size_t uPixel = 0; uPixel < FuPixels; uPixel++)
+    {
+        const uint8_t* pu8Px = &Fpu8Rgb[uPixel * 3];
+        FvIndices[uPixel] = xMap[((uint32_t)pu8Px[0] << 16) | (pu8Px[1] << 8) | pu8Px[2]];
+    }
+}
+
+/*********************************************************************************
+ * @brief Same index repeated from Fu16Pos, up to IMG_RLE_MAX_RUN
+ *
+ ********************************************************************************/
+static uint16_t u16Lpi_RunLength(const uint8_t* Fpu8Indices, uint16_t Fu16Pos, uint16_t Fu16Count)
+{
+    uint16_t u16End = Fu16Pos + 1;
+
+    while ((u16End < Fu16Count) && ((u16End - Fu16Pos) < IMG_RLE_MAX_RUN) && (Fpu8Indices[u16End] == Fpu8Indices[Fu16Pos]))
+    { u16End++; }
+    return u16End - Fu16Pos;
+}
+
+/*********************************************************************************
+ * @brief RLE pack one column of indices
+ *
+ * @param Fpu8Indices
+ * @param Fu16Count
+ * @param Fu8Bits 4 or 8
+ * @param FvOut appended
+ ********************************************************************************/
+static void vLpi_EncodeColumn(const uint8_t* Fpu8Indices, uint16_t Fu16Count, uint8_t Fu8Bits, std::vector<uint8_t>& FvOut)
+{
+    uint16_t u16Pos = 0;
+
+    while (u16Pos < Fu16Count)
+    {
+        uint16_t u16Run = u16Lpi_RunLength(Fpu8Indices, u16Pos, Fu16Count);
+        uint16_t u16Start = u16Pos;
+
+        if (u16Run >= LPI_MIN_RUN)
+        {
+            FvOut.push_back((uint8_t)(IMG_RLE_RUN | (u16Run - 2)));
+            FvOut.push_back(Fpu8Indices[u16Pos]);
+            u16Pos += u16Run;
+            continue;
+        }
+
+        while ((u16Pos < Fu16Count) && ((u16Pos - u16Start) < IMG_RLE_MAX_LITERAL)
+               && (u16Lpi_RunLength(Fpu8Indices, u16Pos, Fu16Count) < LPI_MIN_RUN))
+        { u16Pos++; }
+        FvOut.push_back((uint8_t)(u16Pos - u16Start - 1));
+        if (Fu8Bits == 8)
+        { FvOut.insert(FvOut.end(), &Fpu8Indices[u16Start], &Fpu8Indices[u16Pos]); }
+        else
+        {
+            for (uint16_t u16Index = u16Start; u16Index < u16Pos; u16Index += 2)
+            {
+                uint8_t u8Low = ((u16Index + 1) < u16Pos) ? Fpu8Indices[u16Index + 1] : 0;
+                FvOut.push_back((uint8_t)((Fpu8Indices[u16Index] << 4) | u8Low));
+            }
+        }
+    }
+}
+
+/*********************************************************************************
+ * @brief Append little endian integers
+ *
+ ********************************************************************************/
+static void vLpi_Put16(std::vector<uint8_t>& FvOut, uint16_t Fu16Value)
+{
+    FvOut.push_back((uint8_t)Fu16Value);
+    FvOut.push_back((uint8_t)(Fu16Value >> 8));
+}
+
+static void vLpi_Put32(std::vector<uint8_t>& FvOut, uint32_t Fu32Value)
+{
+    vLpi_Put16(FvOut, (uint16_t)Fu32Value);
+    vLpi_Put16(FvOut, (uint16_t)(Fu32Value >> 16));
+}
+
+/*********************************************************************************
+* External functions
+*********************************************************************************/
+long lLpi_Write(const char* FpcPath, const uint8_t* Fpu8Rgb, uint16_t Fu16Width, uint16_t Fu16Height, uint8_t Fu8Bits)
+{
+    std::vector<uint8_t> vOut;
+    FILE* pFile;
+
+    if ((Fu16Width == 0) || (Fu16Width == 0xFFFF) || (Fu16Height == 0) || ((Fu8Bits != 24) && (Fu8Bits != 8) && (Fu8Bits != 4)))
+    { return -1; }
+
+    vOut.insert(vOut.end(), (Fu8Bits == 24) ? IMG_MAGIC_RAW : IMG_MAGIC_PAL, ((Fu8Bits == 24) ? IMG_MAGIC_RAW : IMG_MAGIC_PAL) + IMG_MAGIC_SIZE);
+    vLpi_Put16(vOut, Fu16Width);
+    vLpi_Put16(vOut, Fu16Height);
+
+    if (Fu8Bits == 24)
+    { vOut.insert(vOut.end(), Fpu8Rgb, Fpu8Rgb + ((size_t)Fu16Width * Fu16Height * 3)); }
+    else
+    {
+        std::vector<uint8_t> vPalette;
+        std::vector<uint8_t> vIndices;
+        std::vector<uint8_t> vData;
+        std::vector<uint32_t> vOffsets;
+        uint32_t u32DataPos;
+
+        vLpi_Quantize(Fpu8Rgb, (size_t)Fu16Width * Fu16Height, (Fu8Bits == 8) ? 256 : 16, vPalette, vIndices);
+        for (uint16_t u16Column = 0; u16Column < Fu16Width; u16Column++)
+        {
+            vOffsets.push_back((uint32_t)vData.size());
+            vLpi_EncodeColumn(&vIndices[(size_t)u16Column * Fu16Height], Fu16Height, Fu8Bits, vData);
+        }
+        vOffsets.push_back((uint32_t)vData.size());
+
+        vOut.push_back(Fu8Bits);
+        vOut.push_back((uint8_t)((vPalette.size() / 3) - 1));
+        vLpi_Put16(vOut, 0);
+        vOut.insert(vOut.end(), vPalette.begin(), vPalette.end());
+        u32DataPos = (uint32_t)vOut.size() + (((uint32_t)Fu16Width + 1) * 4);
+        for (size_t uColumn = 0; uColumn < vOffsets.size(); uColumn++)
+        { vLpi_Put32(vOut, u32DataPos + vOffsets[uColumn]); }
+        vOut.insert(vOut.end(), vData.begin(), vData.end());
+    }
+
+    pFile = fopen(FpcPath, "wb");
+    if (pFile == NULL)
+    { return -1; }
+    if (fwrite(vOut.data(), 1, vOut.size(), pFile) != vOut.size())
+    {
+        fclose(pFile);
+        return -1;
+    }
+    fclose(pFile);
+    return (long)vOut.size();
+}
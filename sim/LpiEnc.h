@@ -0,0 +1,30 @@
+/**
+ * @brief Host side .lpi image writer, shared by lpiconv and the benchmark
+ * @file LpiEnc.h
+ * @version 0.1
+ * @date 2026-10-17
+ * @author Nello (nello.chom@protonmail.com)
+ *
+ * Formats are described in ImgMng.h.
+ */
+
+#ifndef _LPI_ENC_H_
+#define _LPI_ENC_H_
+
+/*********************************************************************************
+* Includes
+*********************************************************************************/
+#include <stdint.h>
+
+/*********************************************************************************
+* External functions
+*********************************************************************************/
+/**
+ * Fpu8Rgb is column major: r g b of pixel 0 of column 0, then pixel 1...
+ * Fu8Bits 24 writes LPI0, 8 or 4 writes LPI1 with a palette of up to 256 or
+ * 16 colors (median cut when the image has more). Returns the file size, -1
+ * on error.
+ */
+long lLpi_Write(const char* FpcPath, const uint8_t* Fpu8Rgb, uint16_t Fu16Width, uint16_t Fu16Height, uint8_t Fu8Bits);
+
+#endif //_LPI_ENC_H_
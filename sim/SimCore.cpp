@@ -0,0 +1,689 @@
+/**
+ * @brief Host simulator core: virtual clock, GPIO and frame log
+ * @file SimCore.cpp
+ * @version 0.1
+ * @date 2026-10-17
+ * @author Nello (nello.chom@protonmail.com)
+ */
+
+/*********************************************************************************
+* Includes
+*********************************************************************************/
+#include <chrono>
+#include "SimCore.h"
+#include <LittleFS.h>
+
+/*********************************************************************************
+* Types & definitions
+*********************************************************************************/
+#define SIM_WIRE_MAX_PIXELS     4096
+#define SIM_SERIAL_BUFFER       256
+
+/*********************************************************************************
+* Global variables
+*********************************************************************************/
+extern void loop(void);
+
+static uint64_t u64Sim_ClockUs = 0;
+static uint32_t u32Sim_LoopStepUs = SIM_LOOP_STEP_US;
+static uint64_t u64Sim_RunEndUs = 0;        ///< end of the current vSim_Run window
+static bool bSim_Asleep = false;
+static bool bSim_WakePending = false;       ///< woken up, first lit frame not seen yet
+static uint64_t u64Sim_WakeUs = 0;
+static uint8_t tu8Sim_Pins[SIM_NB_PINS];
+static uint8_t tu8Sim_PinModes[SIM_NB_PINS];
+static void (*tpvSim_Isr[SIM_NB_PINS])(void);
+static int ti32Sim_IsrMode[SIM_NB_PINS];
+static volatile uint32_t tu32Sim_PortIn[(SIM_NB_PINS + 31) / 32];
+
+static bool bSim_Capture = true;
+static FILE* pSim_FrameLog = NULL;
+static TstSim_Stats stSim_Stats;
+static TstSim_Frame tstSim_Frames[SIM_FRAME_RING];
+static CRGB trgbSim_Wire[SIM_WIRE_MAX_PIXELS];  ///< what the pixels currently latch
+static uint32_t u32Sim_LastHash = 0;
+
+static void vSim_OutStart(const CRGB* FpData, uint16_t Fu16Count, uint8_t Fu8Brightness);
+static void vSim_OutWait(void);
+static uint8_t u8Sim_OutBusy(void);
+static const TstOut_Driver cstSim_OutDriver = {vSim_OutStart, vSim_OutWait, u8Sim_OutBusy};
+static uint32_t u32Sim_OutUsPerPixel = SIM_WIRE_US_PER_PIXEL;
+static uint32_t u32Sim_OutFixedUs = SIM_WIRE_RESET_US;
+static const CRGB* pSim_OutData = NULL;     ///< buffer being clocked out, NULL when idle
+static uint16_t u16Sim_OutCount = 0;
+static uint32_t u32Sim_OutHash = 0;
+static uint64_t u64Sim_OutEndUs = 0;
+
+HardwareSerial Serial;
+static char tcSim_SerialIn[SIM_SERIAL_BUFFER];
+static uint16_t u16Sim_SerialHead = 0;
+static uint16_t u16Sim_SerialTail = 0;
+
+LittleFSFS LittleFS;
+static char tcSim_FsRoot[256] = ".";
+
+/*********************************************************************************
+* Internal functions
+*********************************************************************************/
+
+/*********************************************************************************
+ * @brief FNV-1a over a pixel range
+ *
+ * @param FpData
+ * @param Fu16Count
+ * @return uint32_t
+ ********************************************************************************/
+static uint32_t u32Sim_Hash(const CRGB* FpData, uint16_t Fu16Count)
+{
+    uint32_t u32Hash = 2166136261UL;
+    const uint8_t* pu8Byte = (const uint8_t*)FpData;
+    for (uint32_t u32Index = 0; u32Index < (uint32_t)Fu16Count * 3; u32Index++)
+    {
+        u32Hash ^= pu8Byte[u32Index];
+        u32Hash *= 16777619UL;
+    }
+    return u32Hash;
+}
+
+/*********************************************************************************
+ * @brief Latch a frame on the simulated strip and record it
+ *
+ * @param FpData
+ * @param Fu16Count
+ * @param Fu8Brightness
+ * @param Fu64StartUs time the transfer started
+ ********************************************************************************/
+static void vSim_Capture(const CRGB* FpData, uint16_t Fu16Count, uint8_t Fu8Brightness, uint64_t Fu64StartUs)
+{
+    if (!bSim_Capture)
+    { return; }
+
+    if (Fu16Count > SIM_WIRE_MAX_PIXELS)
+    { Fu16Count = SIM_WIRE_MAX_PIXELS; }
+    memcpy(trgbSim_Wire, FpData, sizeof(CRGB) * Fu16Count); // tail keeps its latched value
+
+    uint16_t u16Lit = 0;
+    for (uint16_t u16Index = 0; u16Index < Fu16Count; u16Index++)
+    {
+        if (FpData[u16Index] != CRGB(CRGB::Black))
+        { u16Lit++; }
+    }
+    uint32_t u32Hash = u32Sim_Hash(FpData, Fu16Count);
+
+    if (u16Lit)
+    { stSim_Stats.u32LitFrames++; }
+    if (u16Lit && bSim_WakePending)
+    {
+        uint64_t u64LatencyUs = Fu64StartUs - u64Sim_WakeUs;
+        bSim_WakePending = false;
+        stSim_Stats.u32Wakes++;
+        stSim_Stats.u64WakeLatencyUs += u64LatencyUs;
+        if (u64LatencyUs > stSim_Stats.u64WakeLatencyMaxUs)
+        { stSim_Stats.u64WakeLatencyMaxUs = u64LatencyUs; }
+    }
+    if (u32Hash != u32Sim_LastHash)
+    { stSim_Stats.u32ChangedFrames++; }
+    u32Sim_LastHash = u32Hash;
+
+    TstSim_Frame* pstFrame = &tstSim_Frames[stSim_Stats.u32ShowCalls % SIM_FRAME_RING];
+    pstFrame->u64TimeUs = Fu64StartUs;
+    pstFrame->u32Hash = u32Hash;
+    pstFrame->u16Count = Fu16Count;
+    pstFrame->u16Lit = u16Lit;
+    pstFrame->u8Brightness = Fu8Brightness;
+
+    if (pSim_FrameLog != NULL)
+    {
+        fprintf(pSim_FrameLog, "%llu,%u,%u,%u,%08x\n", (unsigned long long)Fu64StartUs,
+                Fu16Count, u16Lit, Fu8Brightness, u32Hash);
+    }
+}
+
+/*********************************************************************************
+ * @brief Finish the mock transfer once its end time is reached, a front
+ *        buffer that changed under it counts as a torn frame
+ *
+ ********************************************************************************/
+static void vSim_OutPoll(void)
+{
+    if ((pSim_OutData != NULL) && (u64Sim_ClockUs >= u64Sim_OutEndUs))
+    {
+        if (u32Sim_Hash(pSim_OutData, u16Sim_OutCount) != u32Sim_OutHash)
+        { stSim_Stats.u32OutTorn++; }
+        pSim_OutData = NULL;
+    }
+}
+
+/*********************************************************************************
+ * @brief Mock async driver: the transfer runs in virtual time while loop()
+ *        keeps going, only vSim_OutWait blocks
+ *
+ * @param FpData
+ * @param Fu16Count
+ * @param Fu8Brightness
+ ********************************************************************************/
+static void vSim_OutStart(const CRGB* FpData, uint16_t Fu16Count, uint8_t Fu8Brightness)
+{
+    uint32_t u32WireUs = ((uint32_t)Fu16Count * u32Sim_OutUsPerPixel) + u32Sim_OutFixedUs;
+
+    vSim_OutWait();
+    pSim_OutData = FpData;
+    u16Sim_OutCount = Fu16Count;
+    u32Sim_OutHash = u32Sim_Hash(FpData, Fu16Count);
+    u64Sim_OutEndUs = u64Sim_ClockUs + u32WireUs;
+
+    stSim_Stats.u32ShowCalls++;
+    stSim_Stats.u32OutTransfers++;
+    stSim_Stats.u64PixelsSent += Fu16Count;
+    stSim_Stats.u64WireUs += u32WireUs;
+    vSim_Capture(FpData, Fu16Count, Fu8Brightness, u64Sim_ClockUs);
+}
+
+static void vSim_OutWait(void)
+{
+    if ((pSim_OutData != NULL) && (u64Sim_ClockUs < u64Sim_OutEndUs))
+    {
+        stSim_Stats.u64OutWaitUs += u64Sim_OutEndUs - u64Sim_ClockUs;
+        u64Sim_ClockUs = u64Sim_OutEndUs;
+    }
+    vSim_OutPoll();
+}
+
+static uint8_t u8Sim_OutBusy(void)
+{
+    vSim_OutPoll();
+    return (pSim_OutData != NULL);
+}
+
+/*********************************************************************************
+* Arduino core shim
+*********************************************************************************/
+uint32_t millis(void)
+{
+    return (uint32_t)(u64Sim_ClockUs / 1000);
+}
+
+uint32_t micros(void)
+{
+    return (uint32_t)u64Sim_ClockUs;
+}
+
+void delay(uint32_t Fu32Ms)
+{
+    u64Sim_ClockUs += (uint64_t)Fu32Ms * 1000;
+}
+
+void delayMicroseconds(uint32_t Fu32Us)
+{
+    u64Sim_ClockUs += Fu32Us;
+}
+
+void yield(void)
+{
+}
+
+void pinMode(uint8_t Fu8Pin, uint8_t Fu8Mode)
+{
+    if (Fu8Pin < SIM_NB_PINS)
+    { tu8Sim_PinModes[Fu8Pin] = Fu8Mode; }
+}
+
+int digitalRead(uint8_t Fu8Pin)
+{
+    return (Fu8Pin < SIM_NB_PINS) ? tu8Sim_Pins[Fu8Pin] : LOW;
+}
+
+void digitalWrite(uint8_t Fu8Pin, uint8_t Fu8Level)
+{
+    if ((Fu8Pin < SIM_NB_PINS) && (tu8Sim_PinModes[Fu8Pin] == OUTPUT))
+    { tu8Sim_Pins[Fu8Pin] = Fu8Level ? HIGH : LOW; }
+}
+
+void attachInterrupt(int Fi32Irq, void (*FpvIsr)(void), int Fi32Mode)
+{
+    if ((Fi32Irq >= 0) && (Fi32Irq < SIM_NB_PINS))
+    {
+        tpvSim_Isr[Fi32Irq] = FpvIsr;
+        ti32Sim_IsrMode[Fi32Irq] = Fi32Mode;
+    }
+}
+
+void detachInterrupt(int Fi32Irq)
+{
+    if ((Fi32Irq >= 0) && (Fi32Irq < SIM_NB_PINS))
+    { tpvSim_Isr[Fi32Irq] = NULL; }
+}
+
+volatile uint32_t* portInputRegister(uint8_t Fu8Port)
+{   // pack the pin levels, the firmware dereferences the result right away
+    uint32_t u32Value = 0;
+
+    for (uint8_t u8Bit = 0; (u8Bit < 32) && ((Fu8Port * 32 + u8Bit) < SIM_NB_PINS); u8Bit++)
+    {
+        if (tu8Sim_Pins[Fu8Port * 32 + u8Bit])
+        { u32Value |= (1UL << u8Bit); }
+    }
+    tu32Sim_PortIn[Fu8Port] = u32Value;
+    return &tu32Sim_PortIn[Fu8Port];
+}
+
+void HardwareSerial::begin(uint32_t Fu32Baud)
+{
+}
+
+int HardwareSerial::available(void)
+{
+    return (u16Sim_SerialHead - u16Sim_SerialTail + SIM_SERIAL_BUFFER) % SIM_SERIAL_BUFFER;
+}
+
+int HardwareSerial::read(void)
+{
+    int iChar;
+
+    if (u16Sim_SerialHead == u16Sim_SerialTail)
+    { return -1; }
+    iChar = (uint8_t)tcSim_SerialIn[u16Sim_SerialTail];
+    u16Sim_SerialTail = (u16Sim_SerialTail + 1) % SIM_SERIAL_BUFFER;
+    return iChar;
+}
+
+size_t HardwareSerial::print(const char* FpcText)
+{
+    return (size_t)printf("%s", FpcText);
+}
+
+size_t HardwareSerial::print(char FcChar)
+{
+    return (size_t)printf("%c", FcChar);
+}
+
+size_t HardwareSerial::print(int FiValue)
+{
+    return (size_t)printf("%d", FiValue);
+}
+
+size_t HardwareSerial::print(unsigned int FuValue)
+{
+    return (size_t)printf("%u", FuValue);
+}
+
+size_t HardwareSerial::print(long FlValue)
+{
+    return (size_t)printf("%ld", FlValue);
+}
+
+size_t HardwareSerial::print(unsigned long FulValue)
+{
+    return (size_t)printf("%lu", FulValue);
+}
+
+size_t HardwareSerial::println(void)
+{
+    return (size_t)printf("\n");
+}
+
+size_t HardwareSerial::println(const char* FpcText)
+{
+    return (size_t)printf("%s\n", FpcText);
+}
+
+bool LittleFSFS::begin(bool FbFormatOnFail)
+{
+    return true;
+}
+
+File LittleFSFS::open(const char* FpcPath, const char* FpcMode)
+{
+    char tcPath[512];
+
+    snprintf(tcPath, sizeof(tcPath), "%s%s", tcSim_FsRoot, FpcPath);
+    return File(fopen(tcPath, (FpcMode[0] == 'r') ? "rb" : "wb"));
+}
+
+bool LittleFSFS::exists(const char* FpcPath)
+{
+    File xFile = open(FpcPath, "r");
+    bool bExists = xFile;
+
+    xFile.close();
+    return bExists;
+}
+
+size_t File::read(uint8_t* FpBuffer, size_t FSize)
+{
+    return pFile ? fread(FpBuffer, 1, FSize, pFile) : 0;
+}
+
+bool File::seek(uint32_t Fu32Pos)
+{
+    return pFile && (fseek(pFile, (long)Fu32Pos, SEEK_SET) == 0);
+}
+
+size_t File::position(void)
+{
+    return pFile ? (size_t)ftell(pFile) : 0;
+}
+
+size_t File::size(void)
+{
+    long lPos;
+    long lSize;
+
+    if (pFile == NULL)
+    { return 0; }
+    lPos = ftell(pFile);
+    fseek(pFile, 0, SEEK_END);
+    lSize = ftell(pFile);
+    fseek(pFile, lPos, SEEK_SET);
+    return (size_t)lSize;
+}
+
+void File::close(void)
+{
+    if (pFile != NULL)
+    { fclose(pFile); }
+    pFile = NULL;
+}
+
+/*********************************************************************************
+* External functions
+*********************************************************************************/
+
+/*********************************************************************************
+ * @brief Reset clock, GPIO (idle high, pull-ups) and statistics
+ *
+ ********************************************************************************/
+void vSim_Init(void)
+{
+    u64Sim_ClockUs = 0;
+    u32Sim_LoopStepUs = SIM_LOOP_STEP_US;
+    for (uint8_t u8Pin = 0; u8Pin < SIM_NB_PINS; u8Pin++)
+    {
+        tu8Sim_Pins[u8Pin] = HIGH;
+        tu8Sim_PinModes[u8Pin] = INPUT;
+        tpvSim_Isr[u8Pin] = NULL;
+    }
+    memset((void*)trgbSim_Wire, 0, sizeof(trgbSim_Wire));
+    u32Sim_LastHash = u32Sim_Hash(trgbSim_Wire, 0);
+    pSim_OutData = NULL;
+    u64Sim_RunEndUs = 0;
+    bSim_Asleep = false;
+    bSim_WakePending = false;
+    vSim_ResetStats();
+}
+
+/*********************************************************************************
+ * @brief Virtual time in microseconds (64 bits, never wraps)
+ *
+ * @return uint64_t
+ ********************************************************************************/
+uint64_t u64Sim_Now(void)
+{
+    return u64Sim_ClockUs;
+}
+
+/*********************************************************************************
+ * @brief Jump the virtual clock, e.g. close to a millis() wrap
+ *
+ * @param Fu64Us
+ ********************************************************************************/
+void vSim_SetClock(uint64_t Fu64Us)
+{
+    u64Sim_ClockUs = Fu64Us;
+}
+
+/*********************************************************************************
+ * @brief Advance the virtual clock
+ *
+ * @param Fu64Us
+ ********************************************************************************/
+void vSim_Advance(uint64_t Fu64Us)
+{
+    u64Sim_ClockUs += Fu64Us;
+}
+
+/*********************************************************************************
+ * @brief Virtual time charged for each loop() call
+ *
+ * @param Fu32Us
+ ********************************************************************************/
+void vSim_SetLoopStep(uint32_t Fu32Us)
+{
+    u32Sim_LoopStepUs = Fu32Us ? Fu32Us : 1;
+}
+
+/*********************************************************************************
+ * @brief Drive an input pin, runs the attached pin change ISR like the
+ *        hardware would, in the middle of whatever loop() is doing
+ *
+ * @param Fu8Pin
+ * @param Fu8Level
+ ********************************************************************************/
+void vSim_SetPin(uint8_t Fu8Pin, uint8_t Fu8Level)
+{
+    if (Fu8Pin >= SIM_NB_PINS)
+    { return; }
+
+    uint8_t u8Prev = tu8Sim_Pins[Fu8Pin];
+    tu8Sim_Pins[Fu8Pin] = Fu8Level ? HIGH : LOW;
+    if (bSim_Asleep && (u8Prev != tu8Sim_Pins[Fu8Pin]))
+    {   // pin change wake up
+        bSim_Asleep = false;
+        bSim_WakePending = true;
+        u64Sim_WakeUs = u64Sim_ClockUs;
+    }
+    if ((tpvSim_Isr[Fu8Pin] != NULL) && (u8Prev != tu8Sim_Pins[Fu8Pin]))
+    {
+        int i32Mode = ti32Sim_IsrMode[Fu8Pin];
+        if ((i32Mode == CHANGE) || ((i32Mode == RISING) && tu8Sim_Pins[Fu8Pin]) || ((i32Mode == FALLING) && !tu8Sim_Pins[Fu8Pin]))
+        { tpvSim_Isr[Fu8Pin](); }
+    }
+}
+
+/*********************************************************************************
+ * @brief Read back a pin level
+ *
+ * @param Fu8Pin
+ * @return uint8_t
+ ********************************************************************************/
+uint8_t u8Sim_GetPin(uint8_t Fu8Pin)
+{
+    return (Fu8Pin < SIM_NB_PINS) ? tu8Sim_Pins[Fu8Pin] : LOW;
+}
+
+/*********************************************************************************
+ * @brief Run loop() for a virtual duration
+ *
+ * @param Fu32Ms
+ ********************************************************************************/
+void vSim_Run(uint32_t Fu32Ms)
+{
+    uint64_t u64End = u64Sim_ClockUs + (uint64_t)Fu32Ms * 1000;
+    uint64_t u64Start = u64Sim_ClockUs;
+    u64Sim_RunEndUs = u64End;
+    uint64_t u64Calls = 0;
+    std::chrono::steady_clock::time_point xStart = std::chrono::steady_clock::now();
+
+    while (u64Sim_ClockUs < u64End)
+    {
+        loop();
+        u64Sim_ClockUs += u32Sim_LoopStepUs;
+        vSim_OutPoll();
+        u64Calls++;
+    }
+
+    std::chrono::steady_clock::time_point xEnd = std::chrono::steady_clock::now();
+    stSim_Stats.u64LoopCalls += u64Calls;
+    stSim_Stats.u64HostLoopNs += std::chrono::duration_cast<std::chrono::nanoseconds>(xEnd - xStart).count();
+    stSim_Stats.u64VirtualUs += u64Sim_ClockUs - u64Start;
+}
+
+/*********************************************************************************
+ * @brief Press an active LOW button, hold it, release it and let it settle
+ *
+ * @param Fu8Pin
+ * @param Fu32HoldMs
+ * @param Fu32ReleaseMs
+ ********************************************************************************/
+void vSim_Press(uint8_t Fu8Pin, uint32_t Fu32HoldMs, uint32_t Fu32ReleaseMs)
+{
+    vSim_SetPin(Fu8Pin, LOW);
+    vSim_Run(Fu32HoldMs);
+    vSim_SetPin(Fu8Pin, HIGH);
+    vSim_Run(Fu32ReleaseMs);
+}
+
+/*********************************************************************************
+ * @brief Firmware sleep hook: inputs only change between vSim_Run windows, so
+ *        sleeping skips to the end of the current one. The next pin change
+ *        wakes the device and arms the wake to first lit frame measure.
+ *
+ ********************************************************************************/
+void vSim_Sleep(void)
+{
+    if (u64Sim_RunEndUs > u64Sim_ClockUs)
+    {
+        stSim_Stats.u64SleepUs += u64Sim_RunEndUs - u64Sim_ClockUs;
+        u64Sim_ClockUs = u64Sim_RunEndUs;
+    }
+    stSim_Stats.u32Sleeps++;
+    bSim_Asleep = true;
+    bSim_WakePending = false;   // woke up without lighting anything
+}
+
+/*********************************************************************************
+ * @brief Wire output hook, called by the FastLED shim on every show()
+ *
+ * Charges the WS2812 transfer time to the virtual clock since show() blocks
+ * on target.
+ *
+ * @param FpData
+ * @param Fu16Count
+ * @param Fu8Brightness
+ ********************************************************************************/
+void vSim_OnShow(const CRGB* FpData, uint16_t Fu16Count, uint8_t Fu8Brightness)
+{
+    uint64_t u64Start = u64Sim_ClockUs;
+    uint32_t u32WireUs = ((uint32_t)Fu16Count * SIM_WIRE_US_PER_PIXEL) + SIM_WIRE_RESET_US;
+
+    u64Sim_ClockUs += u32WireUs;
+    stSim_Stats.u32ShowCalls++;
+    stSim_Stats.u64PixelsSent += Fu16Count;
+    stSim_Stats.u64WireUs += u32WireUs;
+    vSim_Capture(FpData, Fu16Count, Fu8Brightness, u64Start);
+}
+
+/*********************************************************************************
+ * @brief Enable frame capture (hash, ring, log), disabled for benchmarks
+ *
+ * @param FbEnable
+ ********************************************************************************/
+void vSim_SetCapture(bool FbEnable)
+{
+    bSim_Capture = FbEnable;
+}
+
+/*********************************************************************************
+ * @brief Stream every show() as a CSV line: time_us,count,lit,brightness,hash
+ *
+ * @param FpFile NULL to stop logging
+ ********************************************************************************/
+void vSim_SetFrameLog(FILE* FpFile)
+{
+    pSim_FrameLog = FpFile;
+    if (pSim_FrameLog != NULL)
+    { fprintf(pSim_FrameLog, "time_us,count,lit,brightness,hash\n"); }
+}
+
+/*********************************************************************************
+ * @brief Clear counters
+ *
+ ********************************************************************************/
+void vSim_ResetStats(void)
+{
+    memset(&stSim_Stats, 0, sizeof(stSim_Stats));
+    memset(tstSim_Frames, 0, sizeof(tstSim_Frames));
+}
+
+/*********************************************************************************
+ * @brief Counters since last reset
+ *
+ * @return const TstSim_Stats*
+ ********************************************************************************/
+const TstSim_Stats* pstSim_GetStats(void)
+{
+    return &stSim_Stats;
+}
+
+/*********************************************************************************
+ * @brief Recent frame from the ring, 0 is the last one
+ *
+ * @param Fu32Back
+ * @return const TstSim_Frame* NULL if not recorded
+ ********************************************************************************/
+const TstSim_Frame* pstSim_GetFrame(uint32_t Fu32Back)
+{
+    if ((Fu32Back >= SIM_FRAME_RING) || (Fu32Back >= stSim_Stats.u32ShowCalls))
+    { return NULL; }
+    return &tstSim_Frames[(stSim_Stats.u32ShowCalls - Fu32Back) % SIM_FRAME_RING];
+}
+
+/*********************************************************************************
+ * @brief Pixel values currently latched by the simulated strip
+ *
+ * @return const CRGB*
+ ********************************************************************************/
+const CRGB* prgbSim_GetWire(void)
+{
+    return trgbSim_Wire;
+}
+
+/*********************************************************************************
+ * @brief Mock async output driver, install it with vOut_SetDriver
+ *
+ * @return const TstOut_Driver*
+ ********************************************************************************/
+const TstOut_Driver* pstSim_GetOutDriver(void)
+{
+    return &cstSim_OutDriver;
+}
+
+/*********************************************************************************
+ * @brief Transfer time modeled by the mock driver
+ *
+ * @param Fu32UsPerPixel
+ * @param Fu32FixedUs latch / setup time per frame
+ ********************************************************************************/
+void vSim_SetOutLatency(uint32_t Fu32UsPerPixel, uint32_t Fu32FixedUs)
+{
+    u32Sim_OutUsPerPixel = Fu32UsPerPixel;
+    u32Sim_OutFixedUs = Fu32FixedUs;
+}
+
+/*********************************************************************************
+ * @brief Queue bytes on the serial input, read by the firmware with
+ *        Serial.read(), overflow is dropped
+ *
+ * @param FpcText
+ ********************************************************************************/
+void vSim_SerialInput(const char* FpcText)
+{
+    while (*FpcText != '\0')
+    {
+        uint16_t u16Next = (u16Sim_SerialHead + 1) % SIM_SERIAL_BUFFER;
+        if (u16Next == u16Sim_SerialTail)
+        { break; }
+        tcSim_SerialIn[u16Sim_SerialHead] = *FpcText++;
+        u16Sim_SerialHead = u16Next;
+    }
+}
+
+/*********************************************************************************
+ * @brief Host directory seen as the root of LittleFS
+ *
+ * @param FpcDir
+ ********************************************************************************/
+void vSim_SetFsRoot(const char* FpcDir)
+{
+    snprintf(tcSim_FsRoot, sizeof(tcSim_FsRoot), "%s", FpcDir);
+}
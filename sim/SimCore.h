@@ -0,0 +1,82 @@
+/**
+ * @brief Host simulator core: virtual clock, GPIO and frame log
+ * @file SimCore.h
+ * @version 0.1
+ * @date 2026-10-17
+ * @author Nello (nello.chom@protonmail.com)
+ */
+
+#ifndef _SIM_CORE_H_
+#define _SIM_CORE_H_
+
+/*********************************************************************************
+* Includes
+*********************************************************************************/
+#include <stdio.h>
+#include <FastLED.h>
+#include "OutMng.h"
+
+/*********************************************************************************
+* Types & definitions
+*********************************************************************************/
+#define SIM_WIRE_US_PER_PIXEL   30      // WS2812 800KHz, 24 bits
+#define SIM_WIRE_RESET_US       50      // latch time
+#define SIM_LOOP_STEP_US        1000    // default virtual cost of one loop()
+#define SIM_FRAME_RING          1024    // frames kept in memory
+
+typedef struct {
+    uint64_t u64TimeUs;     ///< virtual time at show() entry
+    uint32_t u32Hash;       ///< FNV-1a of the pushed pixels
+    uint16_t u16Count;      ///< pixels clocked out
+    uint16_t u16Lit;        ///< non black pixels
+    uint8_t u8Brightness;
+} TstSim_Frame;
+
+typedef struct {
+    uint32_t u32ShowCalls;
+    uint32_t u32LitFrames;      ///< at least one non black pixel
+    uint32_t u32ChangedFrames;  ///< differs from the previous show
+    uint64_t u64PixelsSent;
+    uint64_t u64WireUs;         ///< modeled output time
+    uint64_t u64LoopCalls;
+    uint64_t u64HostLoopNs;     ///< real time spent inside loop()
+    uint64_t u64VirtualUs;      ///< virtual time covered
+    uint32_t u32OutTransfers;   ///< frames started by the mock async driver
+    uint32_t u32OutTorn;        ///< front buffer changed while it was clocked out
+    uint64_t u64OutWaitUs;      ///< time loop() blocked on a transfer in flight
+    uint32_t u32Sleeps;         ///< vSim_Sleep calls
+    uint64_t u64SleepUs;        ///< virtual time spent asleep
+    uint32_t u32Wakes;          ///< wake ups followed by a lit frame
+    uint64_t u64WakeLatencyUs;  ///< sum of wake to first lit frame
+    uint64_t u64WakeLatencyMaxUs;
+} TstSim_Stats;
+
+/*********************************************************************************
+* External functions
+*********************************************************************************/
+void vSim_Init(void);
+uint64_t u64Sim_Now(void);
+void vSim_SetClock(uint64_t Fu64Us);
+void vSim_Advance(uint64_t Fu64Us);
+void vSim_SetLoopStep(uint32_t Fu32Us);
+
+void vSim_SetPin(uint8_t Fu8Pin, uint8_t Fu8Level);
+uint8_t u8Sim_GetPin(uint8_t Fu8Pin);
+void vSim_Run(uint32_t Fu32Ms);
+void vSim_Press(uint8_t Fu8Pin, uint32_t Fu32HoldMs, uint32_t Fu32ReleaseMs);
+void vSim_Sleep(void);
+
+void vSim_OnShow(const CRGB* FpData, uint16_t Fu16Count, uint8_t Fu8Brightness);
+void vSim_SetCapture(bool FbEnable);
+void vSim_SetFrameLog(FILE* FpFile);
+void vSim_ResetStats(void);
+const TstSim_Stats* pstSim_GetStats(void);
+const TstSim_Frame* pstSim_GetFrame(uint32_t Fu32Back);
+const CRGB* prgbSim_GetWire(void);
+
+const TstOut_Driver* pstSim_GetOutDriver(void);
+void vSim_SetOutLatency(uint32_t Fu32UsPerPixel, uint32_t Fu32FixedUs);
+void vSim_SerialInput(const char* FpcText);
+void vSim_SetFsRoot(const char* FpcDir);
+
+#endif //_SIM_CORE_H_
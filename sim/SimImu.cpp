@@ -0,0 +1,212 @@
+/**
+ * @brief Host stand-in for the motion sensor, plays a recorded sample trace
+ * @file SimImu.cpp
+ * @version 0.1
+ * @date 2026-10-17
+ * @author Nello (nello.chom@protonmail.com)
+ *
+ * Trace files are text, one sample per line: time_us,ax,ay,az,gx,gy,gz in raw
+ * sensor units (ImuMng.h scales), '#' lines are comments. The trace starts
+ * when the driver is started and loops. Each read charges SIM_IMU_READ_US of
+ * virtual time like the I2C burst of the real sensor, and returns the latest
+ * sample once.
+ *
+ * The synthetic trace is a series of hand sweeps, alternately left and right,
+ * that speed up along the stroke, with a gyro offset, noise and the
+ * centripetal acceleration of the swing.
+ */
+
+/*********************************************************************************
+* Includes
+*********************************************************************************/
+#include <math.h>
+#include <stdio.h>
+#include <vector>
+#include <Arduino.h>
+#include "SimCore.h"
+#include "SimImu.h"
+
+/*********************************************************************************
+* Types & definitions
+*********************************************************************************/
+#define SIM_IMU_STROKES         6
+#define SIM_IMU_STILL_US        400000
+#define SIM_IMU_SWEEP_US        1000000
+#define SIM_IMU_PEAK_DPS        180.0
+#define SIM_IMU_BIAS            40      // gyro offset, LSB
+#define SIM_IMU_NOISE           6       // gyro and accel noise, +- LSB
+
+typedef struct {
+    uint32_t u32TimeUs;
+    TstImu_Sample stSample;
+} TstSim_ImuPoint;
+
+/*********************************************************************************
+* Global variables
+*********************************************************************************/
+static uint8_t u8Sim_ImuBegin(void);
+static uint8_t u8Sim_ImuRead(TstImu_Sample* FpstSample);
+static const TstImu_Driver cstSim_ImuDriver = {u8Sim_ImuBegin, u8Sim_ImuRead};
+
+static std::vector<TstSim_ImuPoint> vSim_ImuTrace;
+static uint32_t u32Sim_ImuLength = 0;       ///< trace duration, us
+static uint64_t u64Sim_ImuStart = 0;
+static size_t uSim_ImuIndex = 0;
+static size_t uSim_ImuLastRead = SIZE_MAX;
+
+/*********************************************************************************
+* Internal functions
+*********************************************************************************/
+
+/*********************************************************************************
+ * @brief Trace loops after its last sample plus one sample period
+ *
+ ********************************************************************************/
+static void vSim_ImuSetLength(void)
+{
+    size_t uCount = vSim_ImuTrace.size();
+
+    u32Sim_ImuLength = 0;
+    if (uCount >= 2)
+    { u32Sim_ImuLength = (2 * vSim_ImuTrace[uCount - 1].u32TimeUs) - vSim_ImuTrace[uCount - 2].u32TimeUs; }
+    else if (uCount == 1)
+    { u32Sim_ImuLength = vSim_ImuTrace[0].u32TimeUs + 1; }
+}
+
+/*********************************************************************************
+ * @brief Start playing the trace, the synthetic one when none was loaded
+ *
+ * @return uint8_t 1
+ ********************************************************************************/
+static uint8_t u8Sim_ImuBegin(void)
+{
+    if (vSim_ImuTrace.empty())
+    { vSim_SynthImuTrace(); }
+    u64Sim_ImuStart = u64Sim_Now();
+    uSim_ImuIndex = 0;
+    uSim_ImuLastRead = SIZE_MAX;
+    return 1;
+}
+
+/*********************************************************************************
+ * @brief Latest trace sample at the current virtual time
+ *
+ * @param FpstSample
+ * @return uint8_t 1 when it was not returned yet
+ ********************************************************************************/
+static uint8_t u8Sim_ImuRead(TstImu_Sample* FpstSample)
+{
+    uint32_t u32Time;
+
+    delayMicroseconds(SIM_IMU_READ_US);
+    u32Time = (uint32_t)((u64Sim_Now() - u64Sim_ImuStart) % u32Sim_ImuLength);
+    if (u32Time < vSim_ImuTrace[uSim_ImuIndex].u32TimeUs)
+    { uSim_ImuIndex = 0; }     // looped
+    while (((uSim_ImuIndex + 1) < vSim_ImuTrace.size()) && (vSim_ImuTrace[uSim_ImuIndex + 1].u32TimeUs <= u32Time))
+    { uSim_ImuIndex++; }
+
+    if ((uSim_ImuIndex == uSim_ImuLastRead) || (vSim_ImuTrace[uSim_ImuIndex].u32TimeUs > u32Time))
+    { return 0; }
+    uSim_ImuLastRead = uSim_ImuIndex;
+    *FpstSample = vSim_ImuTrace[uSim_ImuIndex].stSample;
+    return 1;
+}
+
+/*********************************************************************************
+ * @brief Deterministic noise, +- SIM_IMU_NOISE
+ *
+ ********************************************************************************/
+static int16_t i16Sim_ImuNoise(void)
+{
+    static uint32_t su32Seed = 12345;
+
+    su32Seed = (su32Seed * 1103515245UL) + 12345UL;
+    return (int16_t)((int32_t)((su32Seed >> 16) % ((2 * SIM_IMU_NOISE) + 1)) - SIM_IMU_NOISE);
+}
+
+/*********************************************************************************
+* External functions
+*********************************************************************************/
+
+/*********************************************************************************
+ * @brief Load a recorded trace, replaces the current one
+ *
+ * @param FpcPath
+ * @return int 0 on success
+ ********************************************************************************/
+int iSim_LoadImuTrace(const char* FpcPath)
+{
+    FILE* pFile = fopen(FpcPath, "r");
+    char tcLine[256];
+
+    if (pFile == NULL)
+    { return -1; }
+    vSim_ImuTrace.clear();
+    while (fgets(tcLine, sizeof(tcLine), pFile) != NULL)
+    {
+        TstSim_ImuPoint stPoint;
+        int tiValues[6];
+        unsigned long ulTime;
+
+        if ((tcLine[0] == '#') || (sscanf(tcLine, "%lu,%d,%d,%d,%d,%d,%d", &ulTime, &tiValues[0], &tiValues[1],
+            &tiValues[2], &tiValues[3], &tiValues[4], &tiValues[5]) != 7))
+        { continue; }
+        stPoint.u32TimeUs = (uint32_t)ulTime;
+        for (uint8_t u8Axis = 0; u8Axis < 3; u8Axis++)
+        {
+            stPoint.stSample.ti16Accel[u8Axis] = (int16_t)tiValues[u8Axis];
+            stPoint.stSample.ti16Gyro[u8Axis] = (int16_t)tiValues[3 + u8Axis];
+        }
+        if (vSim_ImuTrace.empty() || (stPoint.u32TimeUs > vSim_ImuTrace.back().u32TimeUs))
+        { vSim_ImuTrace.push_back(stPoint); }
+    }
+    fclose(pFile);
+    vSim_ImuSetLength();
+    return vSim_ImuTrace.empty() ? -1 : 0;
+}
+
+/*********************************************************************************
+ * @brief Build the synthetic sweep trace, replaces the current one
+ *
+ ********************************************************************************/
+void vSim_SynthImuTrace(void)
+{
+    uint32_t u32Stroke = SIM_IMU_STILL_US + SIM_IMU_SWEEP_US;
+
+    vSim_ImuTrace.clear();
+    for (uint32_t u32Time = 0; u32Time < (SIM_IMU_STROKES * u32Stroke); u32Time += SIM_IMU_SYNTH_PERIOD_US)
+    {
+        TstSim_ImuPoint stPoint;
+        uint32_t u32InStroke = u32Time % u32Stroke;
+        double dSign = ((u32Time / u32Stroke) % 2) ? -1.0 : 1.0;
+        double dDps = 0.0;
+
+        if (u32InStroke >= SIM_IMU_STILL_US)
+        {
+            double dPhase = (double)(u32InStroke - SIM_IMU_STILL_US) / SIM_IMU_SWEEP_US;
+            dDps = dSign * SIM_IMU_PEAK_DPS * sin(M_PI * dPhase) * (0.4 + (1.2 * dPhase));
+        }
+        double dRad = dDps * M_PI / 180.0;
+        double dCentripetalG = (dRad * dRad * IMU_SWEEP_RADIUS_MM / 1000.0) / 9.81;
+
+        stPoint.u32TimeUs = u32Time;
+        stPoint.stSample.ti16Accel[0] = (int16_t)lround(dCentripetalG * IMU_ACCEL_LSB_PER_G) + i16Sim_ImuNoise();
+        stPoint.stSample.ti16Accel[1] = i16Sim_ImuNoise();
+        stPoint.stSample.ti16Accel[2] = IMU_ACCEL_LSB_PER_G + i16Sim_ImuNoise();
+        for (uint8_t u8Axis = 0; u8Axis < 3; u8Axis++)
+        { stPoint.stSample.ti16Gyro[u8Axis] = SIM_IMU_BIAS + i16Sim_ImuNoise(); }
+        stPoint.stSample.ti16Gyro[IMU_SWEEP_AXIS] += (int16_t)lround(dDps * IMU_GYRO_LSB_PER_DPS_X2 / 2.0);
+        vSim_ImuTrace.push_back(stPoint);
+    }
+    vSim_ImuSetLength();
+}
+
+/*********************************************************************************
+ * @brief Trace driver, for vImu_SetDriver
+ *
+ * @return const TstImu_Driver*
+ ********************************************************************************/
+const TstImu_Driver* pstSim_GetImuDriver(void)
+{
+    return &cstSim_ImuDriver;
+}
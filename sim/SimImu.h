@@ -0,0 +1,31 @@
+/**
+ * @brief Host stand-in for the motion sensor, plays a recorded sample trace
+ * @file SimImu.h
+ * @version 0.1
+ * @date 2026-10-17
+ * @author Nello (nello.chom@protonmail.com)
+ */
+
+#ifndef _SIM_IMU_H_
+#define _SIM_IMU_H_
+
+/*********************************************************************************
+* Includes
+*********************************************************************************/
+#include <stdint.h>
+#include "ImuMng.h"
+
+/*********************************************************************************
+* Types & definitions
+*********************************************************************************/
+#define SIM_IMU_READ_US         450     // MPU6050 15 byte burst at 400 kHz
+#define SIM_IMU_SYNTH_PERIOD_US 1000    // synthetic trace sample period
+
+/*********************************************************************************
+* External functions
+*********************************************************************************/
+int iSim_LoadImuTrace(const char* FpcPath);
+void vSim_SynthImuTrace(void);
+const TstImu_Driver* pstSim_GetImuDriver(void);
+
+#endif //_SIM_IMU_H_
@@ -0,0 +1,709 @@
+/**
+ * @brief Host simulator entry point, runs every animation mode end to end
+ * @file SimMain.cpp
+ * @version 0.1
+ * @date 2026-10-17
+ * @author Nello (nello.chom@protonmail.com)
+ *
+ * Usage: lightpen_sim [-t seconds_per_mode] [-s loop_step_us] [-l frames.csv] [-a us_per_pixel] [-p press_period_ms] [-r fs_root] [-i imu.csv] [-g]
+ *
+ * -a swaps the blocking output for the mock async driver with the given
+ * transfer time per pixel.
+ *
+ * -p replaces the single long press per mode by strokes of the given period
+ * (trigger held for the first half), to collect press to light latencies.
+ *
+ * -r is the host directory seen as the LittleFS root by the Image mode.
+ * Without it a test pattern of SIM_IMAGE_WIDTH columns is written to a
+ * temporary directory: pixel p of column c is (c, p, c ^ p).
+ *
+ * -i is a recorded motion trace played by the IMU_MOTION build (format in
+ * SimImu.cpp), a synthetic series of sweeps otherwise.
+ *
+ * -g plays a script of button gestures on the mode button instead (clicks,
+ * double and triple clicks in every menu state, sequences queued behind a
+ * menu transition, late second clicks, a click inside a loop() stall,
+ * holds) and checks the menu state and settings after each one. The run
+ * fails on the first mismatch.
+ *
+ * Built with NET_STREAM=1 the Stream mode is fed over the loopback interface
+ * with the lpsend pattern, a frame every SIM_STREAM_PERIOD_MS. Every
+ * SIM_STREAM_IMPAIR frames one is dropped, one sent twice and one overtaken
+ * by the next: the receiver counters must match, and a lit strip must show
+ * the last frame that got through.
+ *
+ * Built with PROFILING=1 the firmware histograms are cleared at the start of
+ * every mode and dumped after its report line. Timings are virtual: show and
+ * period are modeled, render and buttons cost 0us (host CPU time is what
+ * lightpen_bench measures).
+ */
+
+/*********************************************************************************
+* Includes
+*********************************************************************************/
+#include <stdio.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include "SimCore.h"
+#include "../config.h"
+#include "../AnimMng.h"
+#include "../AnimMngInt.h"
+#include "../OutMng.h"
+#include "../ProfMng.h"
+#include "../ImgMng.h"
+#include "SimImu.h"
+#include "ArtSend.h"
+#include "../NetMng.h"
+
+/*********************************************************************************
+* Types & definitions
+*********************************************************************************/
+#define SIM_DEFAULT_SECONDS     600     // virtual run time per mode
+#define SIM_IMAGE_WIDTH         300     // test pattern columns, 3s at IMG_COLUMN_RATE_HZ
+#define SIM_STREAM_PERIOD_MS    20      // sender frame period
+#define SIM_STREAM_IMPAIR       50      // impairment cycle, frames
+#define SIM_STREAM_DROP         7       // frames of the cycle dropped, duplicated, overtaken
+#define SIM_STREAM_DUPLICATE    23
+#define SIM_STREAM_SWAP         37
+#define SIM_GESTURE_CLICK_MS    60      // press and gap of the clicks in a sequence
+#define SIM_GESTURE_SETTLE_MS   1000    // past TIME_DOUBLE_CLICK and the menu transitions
+
+typedef struct {
+    uint32_t u32Sent;           ///< frames sent, duplicates once
+    uint32_t u32Lost;           ///< expected receiver counters
+    uint32_t u32Stale;
+    uint32_t u32Checked;        ///< lit strip compared to the last frame through
+    uint32_t u32Wrong;
+} TstSim_Stream;
+
+/*********************************************************************************
+* Global variables
+*********************************************************************************/
+extern void setup(void);
+extern CRGB MainLedStip[];
+
+static const char* tpcSim_ModeNames[eAnim_NbRun] = {
+    "Solid",
+    "Fade",
+    "Blink",
+    "Alternate",
+#if (DEVICE_MODE != DEVICE_SIMPLE)
+    "Gradient",
+    "Bicolor",
+    "Edge",
+#endif
+#if IMG_PLAYBACK
+    "Image",
+#endif
+#if NET_STREAM
+    "Stream",
+#endif
+};
+#if NET_STREAM
+static int iSim_StreamSocket = -1;
+static uint8_t u8Sim_StreamSequence = 0;
+static uint32_t u32Sim_StreamFrame = 0;
+static uint32_t u32Sim_StreamShown = 0;     // last frame that got through
+static TstSim_Stream stSim_Stream;
+#endif
+static TstAnim_Snapshot stSim_Expected;     // gesture script, state after the current step
+
+/*********************************************************************************
+* Internal functions
+*********************************************************************************/
+
+/*********************************************************************************
+ * @brief Walk the menu to the next run mode: long push, click, long push
+ *
+ ********************************************************************************/
+static void vSim_NextMode(void)
+{
+    vSim_Press(PIN_MODE, TIME_LONG_PUSH + 100, 200);
+    vSim_Press(PIN_MODE, 100, 200);
+    vSim_Press(PIN_MODE, TIME_LONG_PUSH + 100, 200);
+}
+
+/*********************************************************************************
+ * @brief Click the mode button Fu8Count times in a row, within TIME_DOUBLE_CLICK
+ *
+ * @param Fu8Count
+ ********************************************************************************/
+static void vSim_Clicks(uint8_t Fu8Count)
+{
+    for (uint8_t u8Click = 0; u8Click < Fu8Count; u8Click++)
+    { vSim_Press(PIN_MODE, SIM_GESTURE_CLICK_MS, SIM_GESTURE_CLICK_MS); }
+}
+
+/*********************************************************************************
+ * @brief Let the sequence end, compare the menu state and settings with
+ *        stSim_Expected
+ *
+ * @param FpcStep
+ * @return int 0 when they match
+ ********************************************************************************/
+static int iSim_GestureCheck(const char* FpcStep)
+{
+    TstAnim_Snapshot stState;
+    const TstAnim_Configuration* pstExp = &stSim_Expected.stConfig;
+    const TstAnim_Configuration* pstGot = &stState.stConfig;
+    uint8_t u8Settled;
+
+    vSim_Run(SIM_GESTURE_SETTLE_MS);
+    u8Settled = u8Anim_GetSnapshot(&stState);
+    printf("%-28s state %d mode %d color %u/%u blink %u fade %u edge %u sub %u\n", FpcStep, stState.eState,
+           pstGot->eMode, pstGot->u8MainColorIndex, pstGot->u8SecColorIndex, pstGot->u8BlinkRateIndex,
+           pstGot->u8FadeRateIndex, pstGot->u8EdegeSize, pstGot->u8SubMenu);
+    if (u8Settled && (stState.eState == stSim_Expected.eState) && (pstGot->eMode == pstExp->eMode)
+        && (pstGot->u8MainColorIndex == pstExp->u8MainColorIndex) && (pstGot->u8SecColorIndex == pstExp->u8SecColorIndex)
+        && (pstGot->u8BlinkRateIndex == pstExp->u8BlinkRateIndex) && (pstGot->u8FadeRateIndex == pstExp->u8FadeRateIndex)
+        && (pstGot->u8EdegeSize == pstExp->u8EdegeSize) && (pstGot->u8SubMenu == pstExp->u8SubMenu))
+    { return 0; }
+
+    printf("%-28s expected state %d mode %d color %u/%u blink %u fade %u edge %u sub %u%s\n", "", stSim_Expected.eState,
+           pstExp->eMode, pstExp->u8MainColorIndex, pstExp->u8SecColorIndex, pstExp->u8BlinkRateIndex,
+           pstExp->u8FadeRateIndex, pstExp->u8EdegeSize, pstExp->u8SubMenu, u8Settled ? "" : ", events still pending");
+    return 1;
+}
+
+/*********************************************************************************
+ * @brief The clicks just released must be waiting behind a menu transition
+ *
+ * @param FpcStep
+ * @return int 0 when they are
+ ********************************************************************************/
+static int iSim_GestureQueued(const char* FpcStep)
+{
+    TstAnim_Snapshot stState;
+
+    if (!u8Anim_GetSnapshot(&stState))
+    { return 0; }
+    printf("%-28s clicks were not queued behind the transition\n", FpcStep);
+    return 1;
+}
+
+/*********************************************************************************
+ * @brief Play the gesture script from the power on state (Run, Solid)
+ *
+ * @return int 0 when every step left the expected state
+ ********************************************************************************/
+static int iSim_RunGestures(void)
+{
+    TstAnim_Configuration* pstExp = &stSim_Expected.stConfig;
+    uint8_t u8Color;
+
+    vSim_Run(SIM_GESTURE_SETTLE_MS);
+    u8Anim_GetSnapshot(&stSim_Expected);
+    u8Color = pstExp->u8MainColorIndex;
+    if ((stSim_Expected.eState != eAnim_StateRun) || (pstExp->eMode != eAnim_RunSolid))
+    {
+        printf("%-28s not in the Run state, Solid mode\n", "power on");
+        return 1;
+    }
+
+    // Run: a click steps the main color, a double click steps it back from
+    // before the first click, a triple click restores it
+    vSim_Clicks(1);
+    pstExp->u8MainColorIndex = (u8Color + 1) % ANIM_COLOR_NB;
+    if (iSim_GestureCheck("run click")) { return 1; }
+
+    vSim_Clicks(2);
+    pstExp->u8MainColorIndex = u8Color;
+    if (iSim_GestureCheck("run double click")) { return 1; }
+
+    vSim_Clicks(3);
+    if (iSim_GestureCheck("run triple click")) { return 1; }
+
+    // second click after TIME_DOUBLE_CLICK: two single clicks
+    vSim_Press(PIN_MODE, SIM_GESTURE_CLICK_MS, TIME_DOUBLE_CLICK + 100);
+    vSim_Press(PIN_MODE, SIM_GESTURE_CLICK_MS, SIM_GESTURE_CLICK_MS);
+    pstExp->u8MainColorIndex = (u8Color + 2) % ANIM_COLOR_NB;
+    if (iSim_GestureCheck("run late double click")) { return 1; }
+
+    // press and release while loop() is stalled: both edges come out of one
+    // drain of the edge queue
+    vSim_SetPin(PIN_MODE, LOW);
+    vSim_Advance(80000);
+    vSim_SetPin(PIN_MODE, HIGH);
+    vSim_Advance(170000);
+    pstExp->u8MainColorIndex = (u8Color + 3) % ANIM_COLOR_NB;
+    if (iSim_GestureCheck("run click, loop stalled")) { return 1; }
+
+    // hold then release: one long click, the release is not a click
+    vSim_Press(PIN_MODE, TIME_LONG_PUSH + 100, SIM_GESTURE_CLICK_MS);
+    stSim_Expected.eState = eAnim_StateSelect;
+    if (iSim_GestureCheck("run hold")) { return 1; }
+
+    // Select: the clicks step the mode
+    vSim_Clicks(1);
+    pstExp->eMode = eAnim_RunFade;
+    if (iSim_GestureCheck("select click")) { return 1; }
+
+    vSim_Clicks(1);
+    pstExp->eMode = eAnim_RunBlink;
+    if (iSim_GestureCheck("select click")) { return 1; }
+
+    vSim_Clicks(2);
+    pstExp->eMode = eAnim_RunFade;
+    if (iSim_GestureCheck("select double click")) { return 1; }
+
+    vSim_Clicks(3);
+    stSim_Expected.eState = eAnim_StateRun;
+    if (iSim_GestureCheck("select triple click")) { return 1; }
+
+    // a double click split by the menu entry flash, replayed after it
+    vSim_Press(PIN_MODE, TIME_LONG_PUSH + 100, SIM_GESTURE_CLICK_MS);
+    vSim_Clicks(2);
+    if (iSim_GestureQueued("select double click queued")) { return 1; }
+    stSim_Expected.eState = eAnim_StateSelect;
+    pstExp->eMode = eAnim_RunSolid;
+    if (iSim_GestureCheck("select double click queued")) { return 1; }
+
+    vSim_Clicks(1);
+    pstExp->eMode = eAnim_RunFade;
+    if (iSim_GestureCheck("select click")) { return 1; }
+
+    vSim_Clicks(1);
+    pstExp->eMode = eAnim_RunBlink;
+    if (iSim_GestureCheck("select click")) { return 1; }
+
+    // a trigger click between the two clicks of a double click: the double
+    // click only rolls the mode back, the SubParam state stays
+    vSim_Clicks(1);
+    vSim_Press(PIN_BUTTON, SIM_GESTURE_CLICK_MS, SIM_GESTURE_CLICK_MS);
+    vSim_Clicks(1);
+    stSim_Expected.eState = eAnim_eStateSubParam;
+    pstExp->eMode = eAnim_RunFade;
+    if (iSim_GestureCheck("select click, trigger, click")) { return 1; }
+
+    vSim_Press(PIN_MODE, TIME_LONG_PUSH + 100, SIM_GESTURE_CLICK_MS);
+    stSim_Expected.eState = eAnim_StateSelect;
+    if (iSim_GestureCheck("subparam hold")) { return 1; }
+
+    vSim_Clicks(1);
+    pstExp->eMode = eAnim_RunBlink;
+    if (iSim_GestureCheck("select click")) { return 1; }
+
+    // SubParam, entered with the trigger: the clicks step the blink rate
+    vSim_Press(PIN_BUTTON, SIM_GESTURE_CLICK_MS, SIM_GESTURE_CLICK_MS);
+    stSim_Expected.eState = eAnim_eStateSubParam;
+    if (iSim_GestureCheck("trigger click")) { return 1; }
+
+    vSim_Clicks(1);
+    pstExp->u8BlinkRateIndex = 1;
+    if (iSim_GestureCheck("subparam click")) { return 1; }
+
+    vSim_Clicks(2);
+    pstExp->u8BlinkRateIndex = 0;
+    if (iSim_GestureCheck("subparam double click")) { return 1; }
+
+    vSim_Clicks(1);
+    pstExp->u8BlinkRateIndex = 1;
+    if (iSim_GestureCheck("subparam click")) { return 1; }
+
+    vSim_Clicks(1);
+    pstExp->u8BlinkRateIndex = 2;
+    if (iSim_GestureCheck("subparam click")) { return 1; }
+
+    vSim_Clicks(3);
+    stSim_Expected.eState = eAnim_StateRun;
+    if (iSim_GestureCheck("subparam triple click")) { return 1; }
+
+    // four clicks in Select: the triple click leaves the menu, the fourth
+    // starts a new sequence queued behind the exit flash, a click in Run
+    // (Blink mode: main color)
+    vSim_Press(PIN_MODE, TIME_LONG_PUSH + 100, SIM_GESTURE_CLICK_MS);
+    stSim_Expected.eState = eAnim_StateSelect;
+    if (iSim_GestureCheck("run hold")) { return 1; }
+    vSim_Clicks(4);
+    if (iSim_GestureQueued("select click x4")) { return 1; }
+    stSim_Expected.eState = eAnim_StateRun;
+    pstExp->u8MainColorIndex = (u8Color + 4) % ANIM_COLOR_NB;
+    if (iSim_GestureCheck("select click x4")) { return 1; }
+
+    // held two periods: long click into the menu, its repeat out of it
+    vSim_SetPin(PIN_MODE, LOW);
+    vSim_Run(TIME_LONG_PUSH + 100);
+    stSim_Expected.eState = eAnim_StateSelect;
+    if (iSim_GestureCheck("run held")) { return 1; }
+    vSim_Run(TIME_LONG_PUSH - SIM_GESTURE_SETTLE_MS);
+    vSim_SetPin(PIN_MODE, HIGH);
+    stSim_Expected.eState = eAnim_StateRun;
+    if (iSim_GestureCheck("run held, repeat, release")) { return 1; }
+
+    return 0;
+}
+
+#if IMG_PLAYBACK
+/*********************************************************************************
+ * @brief Write the test pattern image in a new temporary directory
+ *
+ * @param FpcDir receives the directory, mkdtemp template size
+ * @return int 0 on success
+ ********************************************************************************/
+static int iSim_WriteTestImage(char* FpcDir)
+{
+    char tcPath[64];
+    uint8_t tu8Header[IMG_HEADER_SIZE] = {'L', 'P', 'I', '0',
+        (uint8_t)SIM_IMAGE_WIDTH, (uint8_t)(SIM_IMAGE_WIDTH >> 8), (uint8_t)NB_PIXELS, (uint8_t)(NB_PIXELS >> 8)};
+    FILE* pFile;
+
+    if (mkdtemp(FpcDir) == NULL)
+    { return -1; }
+    snprintf(tcPath, sizeof(tcPath), "%s%s", FpcDir, IMG_PATH);
+    pFile = fopen(tcPath, "wb");
+    if (pFile == NULL)
+    { return -1; }
+
+    fwrite(tu8Header, 1, IMG_HEADER_SIZE, pFile);
+    for (uint16_t u16Column = 0; u16Column < SIM_IMAGE_WIDTH; u16Column++)
+    {
+        for (uint16_t u16Pixel = 0; u16Pixel < NB_PIXELS; u16Pixel++)
+        {
+            uint8_t tu8Rgb[3] = {(uint8_t)u16Column, (uint8_t)u16Pixel, (uint8_t)(u16Column ^ u16Pixel)};
+            fwrite(tu8Rgb, 1, 3, pFile);
+        }
+    }
+    fclose(pFile);
+    return 0;
+}
+#endif
+
+#if NET_STREAM
+/*********************************************************************************
+ * @brief Send frame Fu32Frame of the lpsend pattern
+ *
+ * @param Fu32Frame
+ * @param Fu8Sequence
+ ********************************************************************************/
+static void vSim_StreamSend(uint32_t Fu32Frame, uint8_t Fu8Sequence)
+{
+    uint8_t tu8Rgb[NB_PIXELS * 3];
+
+    for (uint16_t u16Pixel = 0; u16Pixel < NB_PIXELS; u16Pixel++)
+    {
+        tu8Rgb[u16Pixel * 3] = (uint8_t)Fu32Frame;
+        tu8Rgb[(u16Pixel * 3) + 1] = (uint8_t)u16Pixel;
+        tu8Rgb[(u16Pixel * 3) + 2] = (uint8_t)(Fu32Frame ^ u16Pixel);
+    }
+    iArt_SendFrame(iSim_StreamSocket, tu8Rgb, NB_PIXELS, NET_STREAM_UNIVERSE, Fu8Sequence);
+    stSim_Stream.u32Sent++;
+}
+
+/*********************************************************************************
+ * @brief Lit strip must show the last frame that got through
+ *
+ ********************************************************************************/
+static void vSim_StreamCheck(void)
+{
+    const CRGB* pWire = prgbSim_GetWire();
+    uint8_t u8Lit = 0;
+    uint8_t u8Match = 1;
+
+    for (uint16_t u16Pixel = 0; u16Pixel < NB_PIXELS; u16Pixel++)
+    {
+        u8Lit |= pWire[u16Pixel].r | pWire[u16Pixel].g | pWire[u16Pixel].b;
+        u8Match &= (pWire[u16Pixel].r == (uint8_t)u32Sim_StreamShown) && (pWire[u16Pixel].g == (uint8_t)u16Pixel)
+            && (pWire[u16Pixel].b == (uint8_t)(u32Sim_StreamShown ^ u16Pixel));
+    }
+    if (u8Lit)
+    {
+        stSim_Stream.u32Checked++;
+        stSim_Stream.u32Wrong += !u8Match;
+    }
+}
+
+/*********************************************************************************
+ * @brief vSim_Run with a frame sent every SIM_STREAM_PERIOD_MS, impaired
+ *        once per SIM_STREAM_IMPAIR frames
+ *
+ * @param Fu32Ms
+ ********************************************************************************/
+static void vSim_RunStreaming(uint32_t Fu32Ms)
+{
+    for (uint32_t u32Ms = 0; u32Ms < Fu32Ms; u32Ms += SIM_STREAM_PERIOD_MS)
+    {
+        uint32_t u32Phase = u32Sim_StreamFrame % SIM_STREAM_IMPAIR;
+        uint8_t u8Sequence = u8Art_NextSequence(u8Sim_StreamSequence);
+
+        if (u32Phase == SIM_STREAM_DROP)
+        { stSim_Stream.u32Lost += NET_NB_UNIVERSES; }
+        else if (u32Phase == SIM_STREAM_SWAP)
+        {   // the next frame overtakes this one, which comes too late
+            vSim_StreamSend(u32Sim_StreamFrame + 1, u8Art_NextSequence(u8Sequence));
+            vSim_StreamSend(u32Sim_StreamFrame, u8Sequence);
+            stSim_Stream.u32Lost += NET_NB_UNIVERSES;
+            stSim_Stream.u32Stale += NET_NB_UNIVERSES;
+            u32Sim_StreamShown = u32Sim_StreamFrame + 1;
+            u32Sim_StreamFrame++;
+            u8Sequence = u8Art_NextSequence(u8Sequence);
+        }
+        else
+        {
+            vSim_StreamSend(u32Sim_StreamFrame, u8Sequence);
+            if (u32Phase == SIM_STREAM_DUPLICATE)
+            {
+                vSim_StreamSend(u32Sim_StreamFrame, u8Sequence);
+                stSim_Stream.u32Stale += NET_NB_UNIVERSES;
+            }
+            u32Sim_StreamShown = u32Sim_StreamFrame;
+        }
+        u32Sim_StreamFrame++;
+        u8Sim_StreamSequence = u8Sequence;
+
+        vSim_Run(((Fu32Ms - u32Ms) < SIM_STREAM_PERIOD_MS) ? (Fu32Ms - u32Ms) : SIM_STREAM_PERIOD_MS);
+        vSim_StreamCheck();
+    }
+}
+
+/*********************************************************************************
+ * @brief Print the receiver counters, check them against what was sent
+ *
+ * @return int 0 when they match
+ ********************************************************************************/
+static int iSim_StreamReport(void)
+{
+    const TstNet_Stats* pstStats = pstNet_GetStats();
+    double dLatency = pstStats->u32Shown ? ((double)pstStats->u64LatencySumUs / pstStats->u32Shown) : 0.0;
+    uint32_t u32Expected = (stSim_Stream.u32Sent * NET_NB_UNIVERSES) - stSim_Stream.u32Stale;    // packets decoded
+
+    printf("%-10s sent %u frames, %u packets decoded, %u frames shown, lost %u, stale %u, invalid %u, latency %.0fus (max %uus)\n",
+           "", stSim_Stream.u32Sent, pstStats->u32Packets, pstStats->u32Shown, pstStats->u32Lost, pstStats->u32Stale,
+           pstStats->u32Invalid, dLatency, pstStats->u32LatencyMaxUs);
+    if ((pstStats->u32Lost != stSim_Stream.u32Lost) || (pstStats->u32Stale != stSim_Stream.u32Stale)
+        || (pstStats->u32Invalid != 0) || (pstStats->u32Packets != u32Expected))
+    {
+        printf("%-10s expected lost %u, stale %u, %u packets decoded\n", "Stream", stSim_Stream.u32Lost,
+               stSim_Stream.u32Stale, u32Expected);
+        return 1;
+    }
+    if ((stSim_Stream.u32Checked == 0) || stSim_Stream.u32Wrong)
+    {
+        printf("%-10s %u of %u lit frames are not the last frame received\n", "Stream", stSim_Stream.u32Wrong,
+               stSim_Stream.u32Checked);
+        return 1;
+    }
+    return 0;
+}
+#endif
+
+/*********************************************************************************
+ * @brief Print one result line
+ *
+ * @param FpcName
+ * @param Fu32Missed frame slots dropped by the scheduler during the run
+ ********************************************************************************/
+static void vSim_Report(const char* FpcName, uint32_t Fu32Missed)
+{
+    const TstSim_Stats* pstStats = pstSim_GetStats();
+    uint64_t u64BlockedUs = pstStats->u32OutTransfers ? pstStats->u64OutWaitUs : pstStats->u64WireUs;
+    double dBlocked = pstStats->u64VirtualUs ? (100.0 * u64BlockedUs / pstStats->u64VirtualUs) : 0.0;
+    double dSleep = pstStats->u64VirtualUs ? (100.0 * pstStats->u64SleepUs / pstStats->u64VirtualUs) : 0.0;
+    double dWakeMs = pstStats->u32Wakes ? (pstStats->u64WakeLatencyUs / 1000.0 / pstStats->u32Wakes) : 0.0;
+    double dSeconds = pstStats->u64VirtualUs / 1e6;
+    double dWireBusy = pstStats->u64VirtualUs ? (100.0 * pstStats->u64WireUs / pstStats->u64VirtualUs) : 0.0;
+    double dNsPerLoop = pstStats->u64LoopCalls ? ((double)pstStats->u64HostLoopNs / pstStats->u64LoopCalls) : 0.0;
+
+    printf("%-10s %9.0f %10llu %9u %8.2f %9u %9u %7.2f%% %9.1f %8u %7.2f%% %6u %7.2f%% %8.1f %8.1f\n", FpcName, dSeconds,
+           (unsigned long long)pstStats->u64LoopCalls, pstStats->u32ShowCalls,
+           dSeconds > 0 ? pstStats->u32ShowCalls / dSeconds : 0.0,
+           pstStats->u32LitFrames, pstStats->u32ChangedFrames, dWireBusy, dNsPerLoop, Fu32Missed,
+           dBlocked, pstStats->u32OutTorn, dSleep, dWakeMs, pstStats->u64WakeLatencyMaxUs / 1000.0);
+}
+
+/*********************************************************************************
+* External functions
+*********************************************************************************/
+int main(int argc, char** argv)
+{
+    uint32_t u32Seconds = SIM_DEFAULT_SECONDS;
+    uint32_t u32StepUs = SIM_LOOP_STEP_US;
+    FILE* pLog = NULL;
+    int32_t i32AsyncUsPerPixel = -1;
+    uint32_t u32PressMs = 0;
+    const char* pcFsRoot = NULL;
+    const char* pcImuTrace = NULL;
+    uint8_t u8Gestures = 0;
+    int iOpt;
+    int iResult = 0;
+
+    while ((iOpt = getopt(argc, argv, "t:s:l:a:p:r:i:g")) != -1)
+    {
+        switch (iOpt)
+        {
+            case 't':
+            u32Seconds = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+
+            case 's':
+            u32StepUs = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+
+            case 'l':
+            pLog = fopen(optarg, "w");
+            if (pLog == NULL)
+            {
+                perror(optarg);
+                return 1;
+            }
+            break;
+
+            case 'a':
+            i32AsyncUsPerPixel = (int32_t)strtol(optarg, NULL, 0);
+            break;
+
+            case 'p':
+            u32PressMs = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+
+            case 'r':
+            pcFsRoot = optarg;
+            break;
+
+            case 'i':
+            pcImuTrace = optarg;
+            break;
+
+            case 'g':
+            u8Gestures = 1;
+            break;
+
+            default:
+            fprintf(stderr, "usage: %s [-t seconds_per_mode] [-s loop_step_us] [-l frames.csv] [-a us_per_pixel] [-p press_period_ms] [-r fs_root] [-i imu.csv] [-g]\n", argv[0]);
+            return 1;
+        }
+    }
+
+#if IMG_PLAYBACK
+    char tcImageDir[] = "/tmp/lightpen_XXXXXX";
+    if (pcFsRoot == NULL)
+    {
+        if (iSim_WriteTestImage(tcImageDir) != 0)
+        {
+            perror("test image");
+            return 1;
+        }
+        pcFsRoot = tcImageDir;
+    }
+#endif
+
+    vSim_Init();
+    if (pcFsRoot != NULL)
+    { vSim_SetFsRoot(pcFsRoot); }
+    vSim_SetLoopStep(u32StepUs);
+    vSim_SetFrameLog(pLog);
+    setup();
+#if IMU_MOTION
+    if ((pcImuTrace != NULL) && (iSim_LoadImuTrace(pcImuTrace) != 0))
+    {
+        perror(pcImuTrace);
+        return 1;
+    }
+    vImu_SetDriver(pstSim_GetImuDriver());
+#else
+    (void)pcImuTrace;
+#endif
+#if NET_STREAM
+    iSim_StreamSocket = iArt_Open("127.0.0.1", NET_STREAM_PORT);
+    if (!u8Net_IsReady() || (iSim_StreamSocket < 0))
+    {
+        fprintf(stderr, "UDP port %d on the loopback interface is not available\n", NET_STREAM_PORT);
+        return 1;
+    }
+#endif
+    if (i32AsyncUsPerPixel >= 0)
+    {
+        vSim_SetOutLatency((uint32_t)i32AsyncUsPerPixel, SIM_WIRE_RESET_US);
+        vOut_SetDriver(pstSim_GetOutDriver());
+    }
+    vSim_Run(100);
+
+    if (u8Gestures)
+    {
+        printf("DEVICE_MODE=%d NB_PIXELS=%d, gesture script, loop step %uus\n", DEVICE_MODE, NB_PIXELS, u32StepUs);
+        iResult = iSim_RunGestures();
+        printf("%s\n", iResult ? "gesture script FAILED" : "gesture script passed");
+    }
+    else
+    {
+        printf("DEVICE_MODE=%d NB_PIXELS=%d REFRESH_RATE_HZ=%d, %us per mode (trigger held half the time), loop step %uus, %s output\n",
+               DEVICE_MODE, NB_PIXELS, REFRESH_RATE_HZ, u32Seconds, u32StepUs, (i32AsyncUsPerPixel >= 0) ? "async" : "blocking");
+        printf("%-10s %9s %10s %9s %8s %9s %9s %8s %9s %8s %8s %6s %8s %8s %8s\n", "mode", "virt_s", "loops", "shows", "shows/s",
+               "lit", "changed", "wire", "ns/loop", "missed", "blocked", "torn", "asleep", "wake_ms", "wake_max");
+    }
+
+    for (uint8_t u8Mode = 0; (u8Mode < eAnim_NbRun) && !u8Gestures; u8Mode++)
+    {
+        if (u8Mode)
+        {
+            vSim_NextMode();
+            vSim_Run(1000);     // let the menu exit flash end, the pen goes idle
+        }
+
+        vSim_ResetStats();
+#if PROFILING
+        vSim_SerialInput("r");
+#endif
+        uint32_t u32Missed = u32Anim_GetMissedFrames();
+        void (*pvRun)(uint32_t) = vSim_Run;
+#if NET_STREAM
+        if (u8Mode == eAnim_RunStream)
+        {
+            pvRun = vSim_RunStreaming;
+            vNet_ResetStats();
+        }
+#endif
+        if (u32PressMs)
+        {
+            for (uint32_t u32Ms = 0; u32Ms < (u32Seconds * 1000); u32Ms += u32PressMs)
+            {
+                vSim_SetPin(PIN_BUTTON, LOW);
+                pvRun(u32PressMs / 2);
+                vSim_SetPin(PIN_BUTTON, HIGH);
+                pvRun(u32PressMs - (u32PressMs / 2));
+            }
+        }
+        else
+        {
+            vSim_SetPin(PIN_BUTTON, LOW);
+            pvRun(u32Seconds * 500);
+            vSim_SetPin(PIN_BUTTON, HIGH);
+            pvRun(u32Seconds * 500);
+        }
+        vSim_Report(tpcSim_ModeNames[u8Mode], u32Anim_GetMissedFrames() - u32Missed);
+#if NET_STREAM
+        if (u8Mode == eAnim_RunStream)
+        { iResult |= iSim_StreamReport(); }
+#endif
+#if PROFILING
+        vSim_SerialInput("p");
+        vSim_Run(1);
+        fflush(stdout);
+#endif
+        if (pstSim_GetStats()->u32OutTorn)
+        {
+            printf("%-10s front buffer changed during a transfer\n", tpcSim_ModeNames[u8Mode]);
+            iResult = 1;
+        }
+        if (memcmp(prgbSim_GetWire(), MainLedStip, sizeof(CRGB) * NB_PIXELS) != 0)
+        {
+            printf("%-10s strip content differs from the frame buffer\n", tpcSim_ModeNames[u8Mode]);
+            iResult = 1;
+        }
+    }
+
+    if (pLog != NULL)
+    { fclose(pLog); }
+#if NET_STREAM
+    vArt_Close(iSim_StreamSocket);
+#endif
+#if IMG_PLAYBACK
+    if (pcFsRoot == tcImageDir)
+    {
+        char tcPath[64];
+        snprintf(tcPath, sizeof(tcPath), "%s%s", tcImageDir, IMG_PATH);
+        unlink(tcPath);
+        rmdir(tcImageDir);
+    }
+#endif
+    return iResult;
+}
@@ -0,0 +1,137 @@
+/**
+ * @brief Host side WiFi and WiFiUDP shims
+ * @file SimNet.cpp
+ * @version 0.1
+ * @date 2026-10-17
+ * @author Nello (nello.chom@protonmail.com)
+ *
+ * The socket is bound to the loopback interface: packets come from the
+ * simulator itself or from lpsend on the same host.
+ */
+
+/*********************************************************************************
+* Includes
+*********************************************************************************/
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <WiFi.h>
+
+/*********************************************************************************
+* Global variables
+*********************************************************************************/
+WiFiClass WiFi;
+
+/*********************************************************************************
+* External functions
+*********************************************************************************/
+
+/*********************************************************************************
+ * @brief Bind 127.0.0.1:Fu16Port, non blocking
+ *
+ * @param Fu16Port
+ * @return uint8_t 1 on success
+ ********************************************************************************/
+uint8_t WiFiUDP::begin(uint16_t Fu16Port)
+{
+    struct sockaddr_in stAddr;
+
+    stop();
+    iSocket = socket(AF_INET, SOCK_DGRAM, 0);
+    if (iSocket < 0)
+    { return 0; }
+    memset(&stAddr, 0, sizeof(stAddr));
+    stAddr.sin_family = AF_INET;
+    stAddr.sin_port = htons(Fu16Port);
+    stAddr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if ((bind(iSocket, (struct sockaddr*)&stAddr, sizeof(stAddr)) != 0)
+        || (fcntl(iSocket, F_SETFL, fcntl(iSocket, F_GETFL) | O_NONBLOCK) != 0))
+    {
+        stop();
+        return 0;
+    }
+    return 1;
+}
+
+/*********************************************************************************
+ * @brief Close the socket
+ *
+ ********************************************************************************/
+void WiFiUDP::stop(void)
+{
+    if (iSocket >= 0)
+    { close(iSocket); }
+    iSocket = -1;
+    iSize = 0;
+    iPos = 0;
+}
+
+/*********************************************************************************
+ * @brief Take the next datagram, the rest of the current one is dropped
+ *
+ * @return int datagram size, 0 when none is pending
+ ********************************************************************************/
+int WiFiUDP::parsePacket(void)
+{
+    ssize_t xSize;
+
+    iSize = 0;
+    iPos = 0;
+    if (iSocket < 0)
+    { return 0; }
+    xSize = recv(iSocket, tu8Packet, sizeof(tu8Packet), MSG_DONTWAIT);
+    if (xSize <= 0)
+    { return 0; }
+    iSize = (int)xSize;
+    return iSize;
+}
+
+/*********************************************************************************
+ * @brief Bytes left in the current datagram
+ *
+ * @return int
+ ********************************************************************************/
+int WiFiUDP::available(void)
+{
+    return iSize - iPos;
+}
+
+/*********************************************************************************
+ * @brief One byte of the current datagram
+ *
+ * @return int -1 at the end
+ ********************************************************************************/
+int WiFiUDP::read(void)
+{
+    return (iPos < iSize) ? tu8Packet[iPos++] : -1;
+}
+
+/*********************************************************************************
+ * @brief Copy bytes of the current datagram
+ *
+ * @param FpBuffer
+ * @param FSize
+ * @return int bytes copied
+ ********************************************************************************/
+int WiFiUDP::read(uint8_t* FpBuffer, size_t FSize)
+{
+    int iCount = available();
+
+    if ((size_t)iCount > FSize)
+    { iCount = (int)FSize; }
+    memcpy(FpBuffer, &tu8Packet[iPos], iCount);
+    iPos += iCount;
+    return iCount;
+}
+
+/*********************************************************************************
+ * @brief Drop the rest of the current datagram
+ *
+ ********************************************************************************/
+void WiFiUDP::flush(void)
+{
+    iPos = iSize;
+}
@@ -0,0 +1,34 @@
+/**
+ * @brief Host side WiFi shim, always connected to the loopback interface
+ * @file WiFi.h
+ * @version 0.1
+ * @date 2026-10-17
+ * @author Nello (nello.chom@protonmail.com)
+ */
+
+#ifndef _WIFI_H_
+#define _WIFI_H_
+
+/*********************************************************************************
+* Includes
+*********************************************************************************/
+#include <Arduino.h>
+#include "WiFiUdp.h"
+
+/*********************************************************************************
+* Types & definitions
+*********************************************************************************/
+typedef enum {
+    WL_IDLE_STATUS = 0,
+    WL_CONNECTED = 3
+} wl_status_t;
+
+class WiFiClass {
+public:
+    wl_status_t begin(const char* FpcSsid, const char* FpcPassword) { return WL_CONNECTED; }
+    wl_status_t status(void) { return WL_CONNECTED; }
+};
+
+extern WiFiClass WiFi;
+
+#endif //_WIFI_H_
@@ -0,0 +1,44 @@
+/**
+ * @brief Host side WiFiUDP shim, a non blocking POSIX datagram socket
+ * @file WiFiUdp.h
+ * @version 0.1
+ * @date 2026-10-17
+ * @author Nello (nello.chom@protonmail.com)
+ *
+ * Receive subset of the ESP32 WiFiUDP API with the same buffering:
+ * parsePacket() takes the next datagram whole, read() copies from it and the
+ * next parsePacket() drops what was not read.
+ */
+
+#ifndef _WIFI_UDP_H_
+#define _WIFI_UDP_H_
+
+/*********************************************************************************
+* Includes
+*********************************************************************************/
+#include <Arduino.h>
+
+/*********************************************************************************
+* Types & definitions
+*********************************************************************************/
+#define SIM_UDP_MAX_PACKET      1500
+
+class WiFiUDP {
+public:
+    WiFiUDP() : iSocket(-1), iSize(0), iPos(0) {}
+    uint8_t begin(uint16_t Fu16Port);
+    void stop(void);
+    int parsePacket(void);
+    int available(void);
+    int read(void);
+    int read(uint8_t* FpBuffer, size_t FSize);
+    void flush(void);
+
+private:
+    int iSocket;
+    int iSize;
+    int iPos;
+    uint8_t tu8Packet[SIM_UDP_MAX_PACKET];
+};
+
+#endif //_WIFI_UDP_H_
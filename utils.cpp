@@ -4,135 +4,425 @@
  * @version 0.1
  * @date 2025-07-17
  * @author Nello (nello.chom@protonmail.com)
+ *
+ * Inputs are described by ctstUtils_Inputs, one bit each in the debouncer
+ * words. A pin change interrupt on any input pushes {port snapshot,
+ * micros()} into a single producer / single consumer ring, so edges are
+ * captured with their time even while loop() is stalled (file reads, UDP
+ * drain, blocking show). vUtils_ButtonManager replays the snapshots in
+ * order, rebuilding the levels the pins had on every UTILS_SAMPLE_US
+ * sample, whenever loop() gets to it. All inputs are debounced together
+ * with 2 bit vertical counters: a level is committed after
+ * UTILS_DEBOUNCE_SAMPLES consecutive samples that differ from the debounced
+ * state, i.e. once it stayed stable for TIME_DEBOUNCE. The sample grid
+ * restarts on the first edge after the inputs settled, so a clean press is
+ * committed TIME_DEBOUNCE after its pin change, and edge times are the
+ * interrupt times. Pins without interrupt are polled into the same ring.
+ * Committed edges are dispatched through txUtils_Callbacks[input][edge],
+ * and every one of them, with its time, to the edge listener: GestMng
+ * recognizes clicks and holds there, so a press and release replayed in
+ * the same drain still make a click.
  */
 
 /*********************************************************************************
 * Includes
 *********************************************************************************/
 #include "utils.h"
+#include "ProfMng.h"
+#if defined(ARDUINO_ARCH_ESP32)
+#include <esp_sleep.h>
+#include <driver/gpio.h>
+#elif defined(ARDUINO_ARCH_AVR)
+#include <avr/sleep.h>
+#endif
 
 /*********************************************************************************
 * Types & definitions
 *********************************************************************************/
+#define UTILS_DEBOUNCE_SAMPLES  4       // 2 bit vertical counter roll over
+#define UTILS_SAMPLE_US         ((TIME_DEBOUNCE * 1000UL) / (UTILS_DEBOUNCE_SAMPLES - 1))
+#define UTILS_RELEASED          ((uint8_t)((1 << eUtils_NbInput) - 1))  // active LOW, all bits high
+#define UTILS_EDGE_QUEUE_SIZE   16      // power of 2, index is a free running uint8_t
+
+#ifndef IRAM_ATTR
+#define IRAM_ATTR
+#endif
+
+typedef struct {
+    uint8_t u8Pin;
+} TstUtils_Input;
+
 typedef struct {
-    uint8_t u8CurrState;
-    uint8_t u8PrevState;
-    uint32_t u32LastEvent;
-} TstUtils_pin;
+    uint32_t u32TimeUs;
+    uint8_t u8Levels;           // snapshot, bit n is input n
+} TstUtils_EdgeEvent;
 
 /*********************************************************************************
 * Global variables
 *********************************************************************************/
-static TstUtils_pin stUtils_ButtonPin = {1, 1, 0};
-static TstUtils_pin stUtils_ModePin = {1, 1, 0};
+static const TstUtils_Input ctstUtils_Inputs[eUtils_NbInput] = { // indexed by TeUtils_BtnType
+    {PIN_BUTTON},
+    {PIN_MODE}
+};
+
+static pvEdgeCallback txUtils_Callbacks[eUtils_NbInput][eUtils_NbEdge];
+static pvEdgeListener xUtils_EdgeListener = NULL;
+
+static uint8_t tu8Utils_Port[eUtils_NbInput];
+static uint32_t tu32Utils_Mask[eUtils_NbInput];
+static uint32_t tu32Utils_RawTime[eUtils_NbInput];     // us, last pin change
+static uint32_t tu32Utils_EdgeTime[eUtils_NbInput];    // us, pin change behind the debounced level
+
+// one bit per input (up to 8)
+static uint8_t u8Utils_State = UTILS_RELEASED;     // debounced levels
+static uint8_t u8Utils_Cnt0 = 0;                    // vertical counter, low bits
+static uint8_t u8Utils_Cnt1 = 0;                    // vertical counter, high bits
+static uint8_t u8Utils_Level = UTILS_RELEASED;      // raw levels of the last replayed snapshot
+static uint32_t u32Utils_LastSample = 0;
 
-static pvEdgeCallback xUtils_RisingCallback = NULL;
-static pvEdgeCallback xUtils_FallingCallback = NULL;
-static pvEdgeCallback xUtils_CbFallingMode = NULL;
-static pvEdgeCallback xUtils_CbRisingMode = NULL;
-static pvEdgeCallback xUtils_CbLongPushMode = NULL;
+// single producer (pin change ISR, or the poller) / single consumer (vUtils_ButtonManager)
+static volatile TstUtils_EdgeEvent tstUtils_EdgeQueue[UTILS_EDGE_QUEUE_SIZE];
+static volatile uint8_t u8Utils_QueueHead = 0;   // written by producer only
+static volatile uint8_t u8Utils_QueueTail = 0;   // written by consumer only
+static volatile uint8_t u8Utils_QueueOverflow = 0;
+static uint8_t u8Utils_IrqMode = 0;
+
+#if defined(LIGHTPEN_HOST)
+extern void vSim_Sleep(void);       // host simulator: skip to the next input change
+#endif
 
 /*********************************************************************************
 * Internal functions
 *********************************************************************************/
 
 /*********************************************************************************
-* External functions
-*********************************************************************************/
+ * @brief Raw level of every input, inputs on the same port share one read
+ *
+ * @return uint8_t bit n is input n
+ ********************************************************************************/
+static uint8_t IRAM_ATTR u8Utils_Snapshot(void)
+{
+    uint8_t u8Levels = 0;
+    uint8_t u8Port = 0xFF;
+    uint32_t u32Value = 0;
+
+    for (uint8_t u8Input = 0; u8Input < eUtils_NbInput; u8Input++)
+    {
+        if (tu8Utils_Port[u8Input] != u8Port)
+        {
+            u8Port = tu8Utils_Port[u8Input];
+            u32Value = *portInputRegister(u8Port);
+        }
+        if (u32Value & tu32Utils_Mask[u8Input])
+        { u8Levels |= (1 << u8Input); }
+    }
+    return u8Levels;
+}
 
 /*********************************************************************************
- * @brief Setup main button callback function
- * 
- * @param FeEdge 
- * @param xCallback 
+ * @brief Push a port snapshot, called from ISR (or from the poller when the
+ *        pins have no interrupt)
+ *
+ * @param Fu8Levels
  ********************************************************************************/
-void vUtils_SetButtonCallback(TeUtils_Edge FeEdge, pvEdgeCallback xCallback)
+static void IRAM_ATTR vUtils_PushSnapshot(uint8_t Fu8Levels)
 {
-    if (FeEdge == eUtils_Falling)
-    { xUtils_FallingCallback = xCallback; }
-    else
-    { xUtils_RisingCallback = xCallback; }
+    uint8_t u8Head = u8Utils_QueueHead;
+    if ((uint8_t)(u8Head - u8Utils_QueueTail) >= UTILS_EDGE_QUEUE_SIZE)
+    {
+        u8Utils_QueueOverflow = 1;
+        return;
+    }
+    volatile TstUtils_EdgeEvent* pstEvent = &tstUtils_EdgeQueue[u8Head % UTILS_EDGE_QUEUE_SIZE];
+    pstEvent->u32TimeUs = micros();
+    pstEvent->u8Levels = Fu8Levels;
+    u8Utils_QueueHead = u8Head + 1;     // publish after the slot is written
 }
 
 /*********************************************************************************
- * @brief Setup mode button callback function
- * 
- * @param FeEdge 
- * @param xCallback 
+ * @brief Pin change on any input
+ *
  ********************************************************************************/
-void vUtils_SetModeCallback(TeUtils_Edge FeEdge, pvEdgeCallback xCallback)
+static void IRAM_ATTR vUtils_Isr(void)
 {
-    switch(FeEdge)
-    {
-        case eUtils_Falling:
-        xUtils_CbFallingMode = xCallback;
-        break;
+    vUtils_PushSnapshot(u8Utils_Snapshot());
+}
 
-        case eUtils_Rising:
-        xUtils_CbRisingMode = xCallback;
-        break;
+/*********************************************************************************
+ * @brief Fire the listener, then the callback of one input edge
+ *
+ * @param FeInput
+ * @param FeEdge
+ ********************************************************************************/
+static void vUtils_Dispatch(TeUtils_BtnType FeInput, TeUtils_Edge FeEdge)
+{
+    if (xUtils_EdgeListener != NULL)
+    { xUtils_EdgeListener(FeInput, FeEdge, tu32Utils_EdgeTime[FeInput]); }
+    if (txUtils_Callbacks[FeInput][FeEdge] != NULL)
+    { txUtils_Callbacks[FeInput][FeEdge](); }
+}
+
+/*********************************************************************************
+ * @brief Debounce one port snapshot, all inputs in parallel
+ *
+ * @param Fu8Sample raw levels
+ ********************************************************************************/
+static void vUtils_Debounce(uint8_t Fu8Sample)
+{
+    uint8_t u8Delta = Fu8Sample ^ u8Utils_State;
+    uint8_t u8Start = u8Delta & ~(u8Utils_Cnt0 | u8Utils_Cnt1);    // first sample of a new level
+    uint8_t u8Toggle = u8Delta & u8Utils_Cnt0 & u8Utils_Cnt1;      // counter rolls over
+
+    // count samples that differ from the state, any agreeing sample clears the count
+    u8Utils_Cnt1 = (u8Utils_Cnt1 ^ u8Utils_Cnt0) & u8Delta;
+    u8Utils_Cnt0 = ~u8Utils_Cnt0 & u8Delta;
+    u8Utils_State ^= u8Toggle;
+
+    if ((u8Start | u8Toggle) == 0)
+    { return; }
 
-        case eUtils_Long:
-        xUtils_CbLongPushMode = xCallback;
-        break;
+    for (uint8_t u8Input = 0; u8Input < eUtils_NbInput; u8Input++)
+    {
+        uint8_t u8Bit = (1 << u8Input);
+        if (u8Start & u8Bit)
+        { tu32Utils_EdgeTime[u8Input] = tu32Utils_RawTime[u8Input]; }
+        if (u8Toggle & u8Bit)
+        {
+            uint8_t u8Level = (u8Utils_State & u8Bit) ? HIGH : LOW;
+            if (u8Input == eUtils_Button)
+            { PROF_TRACE_EDGE(u8Level, tu32Utils_EdgeTime[u8Input]); }
+            vUtils_Dispatch((TeUtils_BtnType)u8Input, u8Level ? eUtils_Rising : eUtils_Falling);
+        }
     }
 }
 
 /*********************************************************************************
- * @brief Manage buttons interface
+ * @brief Sample the raw levels every UTILS_SAMPLE_US up to a time, skip
+ *        ahead once there is nothing left to count
  *
+ * @param Fu32Until micros() timestamp
  ********************************************************************************/
-void vUtils_ButtonManager(void)
+static void vUtils_SampleUntil(uint32_t Fu32Until)
 {
-    uint8_t u8ReadButton = digitalRead(PIN_BUTTON);
-    uint8_t u8ReadMode = digitalRead(PIN_MODE);
-
-    if (u8ReadButton != stUtils_ButtonPin.u8PrevState)
+    while ((int32_t)(Fu32Until - u32Utils_LastSample) >= (int32_t)UTILS_SAMPLE_US)
     {
-        stUtils_ButtonPin.u32LastEvent = millis();
+        if (((u8Utils_Level ^ u8Utils_State) | u8Utils_Cnt0 | u8Utils_Cnt1) == 0)
+        {   // settled: the next edge is sampled at its own time
+            u32Utils_LastSample = Fu32Until - UTILS_SAMPLE_US;
+            return;
+        }
+        u32Utils_LastSample += UTILS_SAMPLE_US;
+        vUtils_Debounce(u8Utils_Level);
     }
-    if(u8ReadMode != stUtils_ModePin.u8PrevState)
+}
+
+/*********************************************************************************
+ * @brief Replay one queued snapshot: the previous levels held until its time
+ *
+ * @param Fu8Levels
+ * @param Fu32TimeUs
+ ********************************************************************************/
+static void vUtils_Replay(uint8_t Fu8Levels, uint32_t Fu32TimeUs)
+{
+    uint8_t u8Changed;
+
+    vUtils_SampleUntil(Fu32TimeUs);
+    u8Changed = Fu8Levels ^ u8Utils_Level;
+    u8Utils_Level = Fu8Levels;
+    for (uint8_t u8Input = 0; u8Changed != 0; u8Input++, u8Changed >>= 1)
     {
-        stUtils_ModePin.u32LastEvent = millis();
+        if (u8Changed & 1)
+        { tu32Utils_RawTime[u8Input] = Fu32TimeUs; }
     }
+}
+
+/*********************************************************************************
+* External functions
+*********************************************************************************/
 
-    // Button
-    if (((millis() - stUtils_ButtonPin.u32LastEvent) > TIME_DEBOUNCE) && (u8ReadButton != stUtils_ButtonPin.u8CurrState))
+/*********************************************************************************
+ * @brief Configure input pins, start from their current levels, capture
+ *        changes by interrupt when every pin has one
+ *
+ ********************************************************************************/
+void vUtils_Init(void)
+{
+    u8Utils_IrqMode = 1;
+    for (uint8_t u8Input = 0; u8Input < eUtils_NbInput; u8Input++)
     {
-        stUtils_ButtonPin.u8CurrState = u8ReadButton;
-        if (!u8ReadButton && (xUtils_FallingCallback != NULL))
-        { xUtils_FallingCallback(); }
-        else if (u8ReadButton && (xUtils_RisingCallback != NULL))
-        { xUtils_RisingCallback(); }
+        pinMode(ctstUtils_Inputs[u8Input].u8Pin, INPUT_PULLUP);
+        tu8Utils_Port[u8Input] = digitalPinToPort(ctstUtils_Inputs[u8Input].u8Pin);
+        tu32Utils_Mask[u8Input] = digitalPinToBitMask(ctstUtils_Inputs[u8Input].u8Pin);
+        tu32Utils_RawTime[u8Input] = micros();
+        tu32Utils_EdgeTime[u8Input] = tu32Utils_RawTime[u8Input];
+        if (digitalPinToInterrupt(ctstUtils_Inputs[u8Input].u8Pin) == NOT_AN_INTERRUPT)
+        { u8Utils_IrqMode = 0; }
     }
+    u8Utils_State = u8Utils_Snapshot();
+    u8Utils_Level = u8Utils_State;
+    u8Utils_Cnt0 = 0;
+    u8Utils_Cnt1 = 0;
+    u32Utils_LastSample = micros();
 
-    // Mode selector
-    if (((millis() - stUtils_ModePin.u32LastEvent) > TIME_DEBOUNCE) && (u8ReadMode != stUtils_ModePin.u8CurrState))
+    if (u8Utils_IrqMode)
     {
-        stUtils_ModePin.u8CurrState = u8ReadMode;
-        if (!u8ReadMode && xUtils_CbFallingMode != NULL)
-        { xUtils_CbFallingMode(); }
-        if (u8ReadMode && xUtils_CbRisingMode != NULL)
-        { xUtils_CbRisingMode(); }
+        for (uint8_t u8Input = 0; u8Input < eUtils_NbInput; u8Input++)
+        { attachInterrupt(digitalPinToInterrupt(ctstUtils_Inputs[u8Input].u8Pin), vUtils_Isr, CHANGE); }
     }
-    else if (((millis() - stUtils_ModePin.u32LastEvent) > TIME_LONG_PUSH) && (u8ReadMode == stUtils_ModePin.u8CurrState) && (!u8ReadMode))
+}
+
+/*********************************************************************************
+ * @brief Setup an input edge callback
+ *
+ * @param FeInput
+ * @param FeEdge
+ * @param xCallback NULL to remove
+ ********************************************************************************/
+void vUtils_SetCallback(TeUtils_BtnType FeInput, TeUtils_Edge FeEdge, pvEdgeCallback xCallback)
+{
+    if ((FeInput < eUtils_NbInput) && (FeEdge < eUtils_NbEdge))
+    { txUtils_Callbacks[FeInput][FeEdge] = xCallback; }
+}
+
+/*********************************************************************************
+ * @brief Setup main button callback function
+ *
+ * @param FeEdge
+ * @param xCallback
+ ********************************************************************************/
+void vUtils_SetButtonCallback(TeUtils_Edge FeEdge, pvEdgeCallback xCallback)
+{
+    vUtils_SetCallback(eUtils_Button, FeEdge, xCallback);
+}
+
+/*********************************************************************************
+ * @brief Setup mode button callback function
+ *
+ * @param FeEdge
+ * @param xCallback
+ ********************************************************************************/
+void vUtils_SetModeCallback(TeUtils_Edge FeEdge, pvEdgeCallback xCallback)
+{
+    vUtils_SetCallback(eUtils_Select, FeEdge, xCallback);
+}
+
+/*********************************************************************************
+ * @brief Setup the function told about every committed edge of every input,
+ *        before its callback
+ *
+ * @param xListener NULL to remove
+ ********************************************************************************/
+void vUtils_SetEdgeListener(pvEdgeListener xListener)
+{
+    xUtils_EdgeListener = xListener;
+}
+
+/*********************************************************************************
+ * @brief Manage buttons interface, replays the queued snapshots then samples
+ *        the levels up to now
+ *
+ ********************************************************************************/
+void vUtils_ButtonManager(void)
+{
+    uint32_t u32Now = micros();   // before the drain: later snapshots are newer
+
+    if (!u8Utils_IrqMode)
+    {   // no pin change interrupt: poll, the poller is then the only producer
+        uint8_t u8Levels = u8Utils_Snapshot();
+        if (u8Levels != u8Utils_Level)
+        { vUtils_PushSnapshot(u8Levels); }
+    }
+
+    while (u8Utils_QueueTail != u8Utils_QueueHead)
     {
-        if (xUtils_CbLongPushMode != NULL)
-        { xUtils_CbLongPushMode(); }
-        stUtils_ModePin.u32LastEvent = millis(); // will loop at [TIME_LONG_PUSH] rate
+        uint8_t u8Tail = u8Utils_QueueTail;
+        volatile TstUtils_EdgeEvent* pstEvent = &tstUtils_EdgeQueue[u8Tail % UTILS_EDGE_QUEUE_SIZE];
+        uint32_t u32TimeUs = pstEvent->u32TimeUs;
+        uint8_t u8Levels = pstEvent->u8Levels;
+        u8Utils_QueueTail = u8Tail + 1;     // release the slot
+
+        vUtils_Replay(u8Levels, u32TimeUs);
     }
 
-    stUtils_ButtonPin.u8PrevState = u8ReadButton;
-    stUtils_ModePin.u8PrevState = u8ReadMode;
+    if (u8Utils_QueueOverflow)
+    {   // snapshots were lost, resync on the current levels
+        u8Utils_QueueOverflow = 0;
+        u32Now = micros();
+        vUtils_Replay(u8Utils_Snapshot(), u32Now);
+    }
+    vUtils_SampleUntil(u32Now);
+}
+
+/*********************************************************************************
+ * @brief Time the last debounced change of an input started
+ *
+ * @param FeType
+ * @return uint32_t micros() timestamp of the pin change behind it
+ ********************************************************************************/
+uint32_t u32Utils_GetEdgeTime(TeUtils_BtnType FeType)
+{
+    return tu32Utils_EdgeTime[FeType];
+}
+
+/*********************************************************************************
+ * @brief Time of the last input sample, from an edge callback the sample that
+ *        committed the edge
+ *
+ * @return uint32_t micros() timestamp
+ ********************************************************************************/
+uint32_t u32Utils_GetSampleTime(void)
+{
+    return u32Utils_LastSample;
 }
 
 /*********************************************************************************
  * @brief Get button state
- * 
- * @param FeType 
- * @return TeUtils_BtnState 
+ *
+ * @param FeType
+ * @return TeUtils_BtnState
  ********************************************************************************/
 TeUtils_BtnState eUtils_GetButtonState(TeUtils_BtnType FeType)
 {
-    return (FeType == eUtils_Button) ? (TeUtils_BtnState)stUtils_ButtonPin.u8CurrState : (TeUtils_BtnState)stUtils_ModePin.u8CurrState;
+    return (u8Utils_State & (1 << FeType)) ? eUtils_Idle : eUtils_Active;
+}
+
+/*********************************************************************************
+ * @brief All inputs released, debounced, no level change under way and no
+ *        snapshot waiting in the queue
+ *
+ * @return uint8_t
+ ********************************************************************************/
+uint8_t u8Utils_IsIdle(void)
+{
+    return (u8Utils_State == UTILS_RELEASED) && (u8Utils_Level == UTILS_RELEASED) && !(u8Utils_Cnt0 | u8Utils_Cnt1)
+        && (u8Utils_QueueTail == u8Utils_QueueHead) && (u8Utils_Snapshot() == UTILS_RELEASED);
+}
+
+/*********************************************************************************
+ * @brief Sleep until a button is pressed (ESP32 light sleep with GPIO wake,
+ *        AVR idle mode until the next interrupt), then queue a snapshot in
+ *        case the wake up swallowed the pin change interrupt
+ *
+ ********************************************************************************/
+void vUtils_Sleep(void)
+{
+#if defined(ARDUINO_ARCH_ESP32)
+    for (uint8_t u8Input = 0; u8Input < eUtils_NbInput; u8Input++)
+    { gpio_wakeup_enable((gpio_num_t)ctstUtils_Inputs[u8Input].u8Pin, GPIO_INTR_LOW_LEVEL); }
+    esp_sleep_enable_gpio_wakeup();
+    esp_light_sleep_start();
+    for (uint8_t u8Input = 0; u8Input < eUtils_NbInput; u8Input++)
+    { gpio_wakeup_disable((gpio_num_t)ctstUtils_Inputs[u8Input].u8Pin); }
+#elif defined(ARDUINO_ARCH_AVR)
+    set_sleep_mode(SLEEP_MODE_IDLE);    // timer0 keeps millis() running and wakes us each ms
+    sleep_enable();
+    sleep_cpu();
+    sleep_disable();
+#elif defined(LIGHTPEN_HOST)
+    vSim_Sleep();
+#endif
+
+    uint8_t u8Levels = u8Utils_Snapshot();
+    if ((u8Levels != u8Utils_Level) && (u8Utils_QueueTail == u8Utils_QueueHead))
+    { vUtils_PushSnapshot(u8Levels); }
 }
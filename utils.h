@@ -17,15 +17,16 @@
 /*********************************************************************************
 * Types & definitions
 *********************************************************************************/
-typedef enum {
-    eUtils_Button,
-    eUtils_Select
+typedef enum {  // input index in the debouncer, order of ctstUtils_Inputs
+    eUtils_Button = 0,
+    eUtils_Select,
+    eUtils_NbInput
 } TeUtils_BtnType;
 
 typedef enum {
     eUtils_Falling = 0,
     eUtils_Rising,
-    eUtils_Long
+    eUtils_NbEdge
 } TeUtils_Edge;
 
 typedef enum {
@@ -34,14 +35,22 @@ typedef enum {
 } TeUtils_BtnState;
 
 typedef void (*pvEdgeCallback)(void);
+typedef void (*pvEdgeListener)(TeUtils_BtnType FeInput, TeUtils_Edge FeEdge, uint32_t Fu32EdgeTime);
 
 /*********************************************************************************
 * External functions
 *********************************************************************************/
+void vUtils_Init(void);
+void vUtils_SetCallback(TeUtils_BtnType FeInput, TeUtils_Edge FeEdge, pvEdgeCallback xCallback);
 void vUtils_SetButtonCallback(TeUtils_Edge FeEdge, pvEdgeCallback xCallback);
 void vUtils_SetModeCallback(TeUtils_Edge FeEdge, pvEdgeCallback xCallback);
+void vUtils_SetEdgeListener(pvEdgeListener xListener);
 void vUtils_ButtonManager(void);
 TeUtils_BtnState eUtils_GetButtonState(TeUtils_BtnType FeType);
+uint32_t u32Utils_GetEdgeTime(TeUtils_BtnType FeType);
+uint32_t u32Utils_GetSampleTime(void);
+uint8_t u8Utils_IsIdle(void);
+void vUtils_Sleep(void);
 
 
 #endif //_UTILS_H_